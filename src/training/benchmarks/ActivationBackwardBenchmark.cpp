@@ -0,0 +1,65 @@
+// Backward pass of sigmoid and tanh from the pre-activation z, which re-evaluates
+// the activation, against the same pass from the cached outputs, which does not.
+#include <cstdio>
+#include <memory>
+
+#include "Benchmark.h"
+#include "../include/MLP.h"
+#include "../include/activation_functions/Sigmoid.h"
+#include "../include/activation_functions/Tanh.h"
+#include "../include/loss_functions/MSE.h"
+
+namespace
+{
+    // Same activation with the output-based derivative switched off.
+    template<typename A>
+    struct FromInput : A
+    {
+        bool derivativeUsesOutput() const override { return false; }
+    };
+
+    template<typename A>
+    void benchmarkActivation(const char* name, const int rows, const int cols)
+    {
+        A activation;
+        Matrix z(rows, cols), gradient(rows, cols), out(rows, cols);
+        z.randomize(-4.0, 4.0);
+        gradient.randomize(-1.0, 1.0);
+        const Matrix a = activation.forward(z);
+
+        const double fromInput = bestTimeNs([&] { activation.backward(gradient, z, out); });
+        const double fromOutput = bestTimeNs([&] { activation.backwardFromOutput(gradient, a, out); });
+        std::printf("%s %dx%d\n", name, rows, cols);
+        report("  backward from z", fromInput, fromInput);
+        report("  backward from cached output", fromOutput, fromInput);
+    }
+
+    template<typename A>
+    void benchmarkTrainingStep(const char* name)
+    {
+        const std::vector<int> sizes = {256, 512, 512, 10};
+        auto mse = std::make_shared<MSE>();
+        auto cached = std::make_shared<A>();
+        auto recomputed = std::make_shared<FromInput<A>>();
+        MLP fromOutput(sizes, {cached, cached, cached}, 0.01, mse);
+        MLP fromInput(sizes, {recomputed, recomputed, recomputed}, 0.01, mse);
+
+        Matrix x(256, 1), y(10, 1);
+        x.randomize(-1.0, 1.0);
+        y.randomize(0.0, 1.0);
+        const double slow = bestTimeNs([&] { fromInput.backpropagate(x, y); });
+        const double fast = bestTimeNs([&] { fromOutput.backpropagate(x, y); });
+        std::printf("%s MLP 256-512-512-10 training step\n", name);
+        report("  backward from z", slow, slow);
+        report("  backward from cached output", fast, slow);
+    }
+}
+
+int main()
+{
+    benchmarkActivation<Sigmoid>("Sigmoid", 512, 512);
+    benchmarkActivation<Tanh>("Tanh", 512, 512);
+    benchmarkTrainingStep<Sigmoid>("Sigmoid");
+    benchmarkTrainingStep<Tanh>("Tanh");
+    return 0;
+}
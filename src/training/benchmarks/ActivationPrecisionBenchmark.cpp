@@ -0,0 +1,34 @@
+// Forward pass of sigmoid and tanh with ActivationPrecision::Exact against Fast.
+#include <cstdio>
+
+#include "Benchmark.h"
+#include "../include/activation_functions/Sigmoid.h"
+#include "../include/activation_functions/Tanh.h"
+
+namespace
+{
+    template<typename A, typename T>
+    void benchmarkPrecision(const char* name, const int rows, const int cols)
+    {
+        A exact;
+        A fast(ActivationPrecision::Fast);
+        BasicMatrix<T> z(rows, cols), out(rows, cols);
+        z.randomize(-4.0, 4.0);
+
+        const double exactNs = bestTimeNs([&] { exact.forward(z, out); });
+        const double fastNs = bestTimeNs([&] { fast.forward(z, out); });
+        std::printf("%s %dx%d\n", name, rows, cols);
+        report("  exact", exactNs, exactNs);
+        report("  fast", fastNs, exactNs);
+    }
+}
+
+int main()
+{
+    std::printf("Elementwise kernels: %s\n", kernels::isaName(kernels::elementwise<double>().isa));
+    benchmarkPrecision<Sigmoid, double>("Sigmoid", 512, 512);
+    benchmarkPrecision<Tanh, double>("Tanh", 512, 512);
+    benchmarkPrecision<SigmoidF, float>("SigmoidF", 512, 512);
+    benchmarkPrecision<TanhF, float>("TanhF", 512, 512);
+    return 0;
+}
@@ -0,0 +1,39 @@
+#ifndef EDGEMLP_BENCHMARK_H
+#define EDGEMLP_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+// Best-of-N wall time of f() in nanoseconds. Each sample repeats f until it has
+// run for at least a millisecond, so short kernels are timed accurately.
+template<typename F>
+double bestTimeNs(F&& f, const int samples = 7)
+{
+    using Clock = std::chrono::steady_clock;
+    f();
+    double best = 0;
+    for (int s = 0; s < samples; s++)
+    {
+        long reps = 0;
+        const auto start = Clock::now();
+        auto now = start;
+        do
+        {
+            f();
+            reps++;
+            now = Clock::now();
+        } while (now - start < std::chrono::milliseconds(1));
+        const double ns = std::chrono::duration<double, std::nano>(now - start).count() / static_cast<double>(reps);
+        best = s == 0 ? ns : std::min(best, ns);
+    }
+    return best;
+}
+
+// One line per measurement: name, time per call, and the speedup over a baseline.
+inline void report(const char* name, const double ns, const double baselineNs)
+{
+    std::printf("%-40s %12.1f ns %8.2fx\n", name, ns, baselineNs / ns);
+}
+
+#endif //EDGEMLP_BENCHMARK_H
@@ -0,0 +1,52 @@
+// Data-parallel training throughput: each batch of 256 is split into one shard per
+// thread, and shard gradients are combined by the tree all-reduce. It is compared with
+// the plain batched step, which only parallelises inside each GEMM. The baseline is
+// the plain step on one thread.
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+#include "Benchmark.h"
+#include "../include/MLP.h"
+#include "../include/activation_functions/Relu.h"
+#include "../include/activation_functions/Softmax.h"
+#include "../include/loss_functions/CrossEntropy.h"
+
+int main()
+{
+    const std::vector<int> sizes = {256, 512, 512, 10};
+    const int samples = 2048;
+    const int batch = 256;
+    auto relu = std::make_shared<Relu>();
+    auto softmax = std::make_shared<Softmax>();
+    MLP mlp(sizes, {relu, relu, softmax}, 0.01, std::make_shared<CrossEntropy>());
+
+    Matrix X(256, samples), y(10, samples);
+    X.randomize(-1.0, 1.0);
+    for (int c = 0; c < samples; c++)
+    {
+        y(c % 10, c) = 1.0;
+    }
+
+    const int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::printf("MLP 256-512-512-10, batch %d, one epoch of %d samples, %d cores\n", batch, samples, cores);
+    double baseline = 0;
+    for (int threads = 1; threads <= cores; threads *= 2)
+    {
+        ThreadPool::setGlobalThreadCount(threads);
+        const double unsharded = bestTimeNs([&] { mlp.train(X, y, 1, 0.01, batch); }, 3);
+        if (threads == 1)
+        {
+            baseline = unsharded;
+        }
+        const double sharded = bestTimeNs([&] { mlp.train(X, y, 1, 0.01, batch, threads); }, 3);
+        char name[64];
+        std::snprintf(name, sizeof(name), "  %d threads, parallel GEMMs", threads);
+        report(name, unsharded, baseline);
+        std::snprintf(name, sizeof(name), "  %d threads, %d shards (%.0f samples/s)", threads, threads,
+                      samples * 1e9 / sharded);
+        report(name, sharded, baseline);
+    }
+    ThreadPool::setGlobalThreadCount(0);
+    return 0;
+}
@@ -0,0 +1,49 @@
+// A dense layer as three passes (product, bias, activation) against the fused
+// GEMM epilogue that finishes each block of the output while it is in cache.
+#include <cstdio>
+
+#include "Benchmark.h"
+#include "../include/activation_functions/Relu.h"
+#include "../include/activation_functions/Sigmoid.h"
+
+namespace
+{
+    template<typename A>
+    void benchmarkLayer(const char* name, const int outputs, const int inputs, const int batch)
+    {
+        A activation;
+        Matrix weights(outputs, inputs), x(inputs, batch), bias(outputs, 1);
+        Matrix z(outputs, batch), out(outputs, batch);
+        weights.randomize(-1.0, 1.0);
+        x.randomize(-1.0, 1.0);
+        bias.randomize(-1.0, 1.0);
+        Matrix broadcastBias(outputs, batch);
+        for (int i = 0; i < outputs; i++)
+        {
+            for (int j = 0; j < batch; j++)
+            {
+                broadcastBias(i, j) = bias(i, 0);
+            }
+        }
+
+        const double separate = bestTimeNs([&]
+        {
+            gemm(z, weights, x);
+            z += broadcastBias;
+            activation.forward(z, out);
+        });
+        const double fused = bestTimeNs([&] { activation.denseForward(weights, x, bias, out); });
+        std::printf("%s %dx%d layer, batch %d\n", name, outputs, inputs, batch);
+        report("  gemm + bias + activation", separate, separate);
+        report("  fused epilogue", fused, separate);
+    }
+}
+
+int main()
+{
+    benchmarkLayer<Relu>("ReLU", 512, 512, 1);
+    benchmarkLayer<Relu>("ReLU", 512, 512, 256);
+    benchmarkLayer<Sigmoid>("Sigmoid", 512, 512, 256);
+    benchmarkLayer<Relu>("ReLU", 1024, 256, 1024);
+    return 0;
+}
@@ -0,0 +1,41 @@
+// Training throughput of MLP::train by batch size. Batch size 1 updates after every
+// sample and multiplies matrices by vectors; larger batches turn every layer into a GEMM.
+#include <cstdio>
+#include <memory>
+
+#include "Benchmark.h"
+#include "../include/MLP.h"
+#include "../include/activation_functions/Relu.h"
+#include "../include/activation_functions/Softmax.h"
+#include "../include/loss_functions/CrossEntropy.h"
+
+int main()
+{
+    const std::vector<int> sizes = {256, 512, 512, 10};
+    const int samples = 1024;
+    auto relu = std::make_shared<Relu>();
+    auto softmax = std::make_shared<Softmax>();
+    MLP mlp(sizes, {relu, relu, softmax}, 0.01, std::make_shared<CrossEntropy>());
+
+    Matrix X(256, samples), y(10, samples);
+    X.randomize(-1.0, 1.0);
+    for (int c = 0; c < samples; c++)
+    {
+        y(c % 10, c) = 1.0;
+    }
+
+    std::printf("MLP 256-512-512-10, one epoch of %d samples\n", samples);
+    double perSample = 0;
+    for (const int batch : {1, 8, 32, 64, 128, 256})
+    {
+        const double ns = bestTimeNs([&] { mlp.train(X, y, 1, 0.01, batch); }, 3);
+        if (batch == 1)
+        {
+            perSample = ns;
+        }
+        char name[64];
+        std::snprintf(name, sizeof(name), "  batch %3d (%.0f samples/s)", batch, samples * 1e9 / ns);
+        report(name, ns, perSample);
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+// Optimizer updates of a 1024x1024 weight matrix: momentum and Adam composed from
+// separate Matrix passes against the fused kernels that read the gradient and
+// state once and write the parameters and state in place. Then the epochs and
+// time plain SGD and Adam need to fit XOR to the same loss from the same weights.
+#include <cmath>
+#include <cstdio>
+#include <memory>
+
+#include "Benchmark.h"
+#include "../include/MLP.h"
+#include "../include/activation_functions/Sigmoid.h"
+#include "../include/activation_functions/Tanh.h"
+#include "../include/loss_functions/MSE.h"
+#include "../include/optimizers/Adam.h"
+#include "../include/optimizers/Momentum.h"
+
+namespace
+{
+    void benchmarkUpdates(const int n)
+    {
+        Matrix p(n, n), g(n, n), velocity(n, n), m(n, n), v(n, n), scratch(n, n);
+        p.randomize(-1.0, 1.0);
+        g.randomize(-1.0, 1.0);
+        const double lr = 1e-4;
+        std::printf("%dx%d parameters\n", n, n);
+
+        Momentum momentum(0.9);
+        const double separateMomentum = bestTimeNs([&]
+        {
+            velocity *= 0.9;
+            velocity.axpy(1.0, g);
+            p.axpy(-lr, velocity);
+        });
+        const double fusedMomentum = bestTimeNs([&] { momentum.update(0, p, g, lr); });
+        report("  momentum, separate passes", separateMomentum, separateMomentum);
+        report("  momentum, fused", fusedMomentum, separateMomentum);
+
+        Adam adam;
+        adam.beginStep();
+        const double separateAdam = bestTimeNs([&]
+        {
+            m *= 0.9;
+            m.axpy(0.1, g);
+            scratch = g;
+            scratch.hadamardInPlace(g);
+            v *= 0.999;
+            v.axpy(0.001, scratch);
+            const size_t count = static_cast<size_t>(n) * n;
+            double* step = scratch.getData();
+            const double* first = m.getData();
+            const double* second = v.getData();
+            for (size_t i = 0; i < count; i++)
+            {
+                step[i] = first[i] / (std::sqrt(second[i] / 0.001) + 1e-8);
+            }
+            p.axpy(-lr / 0.1, scratch);
+        });
+        const double fusedAdam = bestTimeNs([&] { adam.update(0, p, g, lr); });
+        report("  Adam, separate passes", separateAdam, separateAdam);
+        report("  Adam, fused", fusedAdam, separateAdam);
+    }
+
+    // Full-batch epochs until the loss is below target.
+    int epochsToReach(MLP& mlp, const Matrix& X, const Matrix& y, const double target)
+    {
+        int epochs = 0;
+        while (epochs < 100000 && mlp.loss_function->calculate(mlp.forward(X), y) >= target)
+        {
+            mlp.backpropagate(X, y);
+            epochs++;
+        }
+        return epochs;
+    }
+
+    void benchmarkConvergence()
+    {
+        Matrix X(2, 4), y(1, 4);
+        for (int c = 0; c < 4; c++)
+        {
+            X(0, c) = c >> 1;
+            X(1, c) = c & 1;
+            y(0, c) = X(0, c) != X(1, c) ? 1.0 : 0.0;
+        }
+        auto tanh = std::make_shared<Tanh>();
+        auto sigmoid = std::make_shared<Sigmoid>();
+        const MLP initial({2, 8, 1}, {tanh, sigmoid}, 0.0, std::make_shared<MSE>());
+        const auto train = [&](const double lr, const std::shared_ptr<Optimizer>& optimizer, int& epochs)
+        {
+            MLP mlp({2, 8, 1}, {tanh, sigmoid}, lr, std::make_shared<MSE>());
+            mlp.weights = initial.weights;
+            mlp.biases = initial.biases;
+            mlp.optimizer = optimizer;
+            epochs = epochsToReach(mlp, X, y, 1e-3);
+        };
+        int sgdEpochs = 0, adamEpochs = 0;
+        const double sgd = bestTimeNs([&] { train(0.5, nullptr, sgdEpochs); }, 3);
+        const double adam = bestTimeNs([&] { train(0.05, std::make_shared<Adam>(), adamEpochs); }, 3);
+        std::printf("XOR 2-8-1 to MSE < 1e-3 from the same weights\n");
+        std::printf("  SGD,  lr 0.5:  %d epochs\n", sgdEpochs);
+        std::printf("  Adam, lr 0.05: %d epochs\n", adamEpochs);
+        report("  SGD", sgd, sgd);
+        report("  Adam", adam, sgd);
+    }
+}
+
+int main()
+{
+    benchmarkUpdates(1024);
+    benchmarkConvergence();
+    return 0;
+}
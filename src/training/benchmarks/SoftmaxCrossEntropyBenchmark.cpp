@@ -0,0 +1,48 @@
+// Output-layer gradient of softmax with cross-entropy: softmax, the cross-entropy
+// derivative and the softmax Jacobian-vector product as separate passes, against
+// the fused log-sum-exp pass that produces p - y directly.
+#include <cstdio>
+
+#include "Benchmark.h"
+#include "../include/activation_functions/Softmax.h"
+#include "../include/loss_functions/CrossEntropy.h"
+
+namespace
+{
+    template<typename T>
+    void benchmarkOutputLayer(const char* name, const int classes, const int batch, const ActivationPrecision precision)
+    {
+        BasicSoftmax<T> softmax(precision);
+        BasicCrossEntropy<T> crossEntropy(precision);
+        BasicMatrix<T> z(classes, batch), y(classes, batch);
+        BasicMatrix<T> p(classes, batch), upstream(classes, batch), gradient(classes, batch);
+        z.randomize(-4.0, 4.0);
+        for (int c = 0; c < batch; c++)
+        {
+            y(c % classes, c) = 1;
+        }
+
+        const double separate = bestTimeNs([&]
+        {
+            softmax.forward(z, p);
+            crossEntropy.calculate(p, y);
+            crossEntropy.derivative(p, y, upstream);
+            softmax.backwardFromOutput(upstream, p, gradient);
+        });
+        const double fused = bestTimeNs([&] { crossEntropy.softmaxCrossEntropy(z, y, &gradient); });
+        std::printf("%s %dx%d %s\n", name, classes, batch, precision == ActivationPrecision::Fast ? "fast" : "exact");
+        report("  softmax, loss, derivative, Jacobian", separate, separate);
+        report("  fused softmax cross-entropy", fused, separate);
+    }
+}
+
+int main()
+{
+    for (const ActivationPrecision precision : {ActivationPrecision::Exact, ActivationPrecision::Fast})
+    {
+        benchmarkOutputLayer<double>("double", 10, 256, precision);
+        benchmarkOutputLayer<double>("double", 1000, 64, precision);
+        benchmarkOutputLayer<float>("float", 1000, 64, precision);
+    }
+    return 0;
+}
@@ -2,15 +2,68 @@
 #define EDGEMLP_ACTIVATION_H
 
 #include "Matrix.h"
-class Activation
+
+// How activations built on exp or tanh evaluate them over a buffer.
+enum class ActivationPrecision
+{
+    // Standard library functions.
+    Exact,
+    // SIMD polynomial approximations, several times faster; the maximum errors are
+    // documented in kernels/FastMath.h. The scalar activate() and derivative() stay exact.
+    Fast
+};
+
+// Instantiated for float and double; Activation is the double version.
+template<typename T>
+class BasicActivation
 {
 public:
-    virtual ~Activation() = default;
-    virtual double activate(double x) = 0;
-    virtual double derivative(double x) = 0;
-    Matrix forward(const Matrix& m);
-    Matrix backward(const Matrix& upstreamGradient, const Matrix& activationOutput);
+    virtual ~BasicActivation() = default;
+    virtual T activate(T x) = 0;
+    virtual T derivative(T x) = 0;
+    // Whole-buffer variants, so a layer costs one virtual call instead of one per
+    // element. The defaults loop over activate() and derivative(); the built-in
+    // activations override them with tight loops.
+    // values[i] = activate(values[i]); may run concurrently on disjoint buffers.
+    virtual void forwardInPlace(T* values, size_t count);
+    // gradient[i] *= derivative(input[i]); the buffers must not overlap.
+    virtual void backwardInPlace(T* gradient, const T* input, size_t count);
+    // True when the derivative can be computed from the activation's output alone,
+    // e.g. sigmoid' = y * (1 - y). Backprop then reuses the cached forward outputs
+    // instead of re-evaluating the activation on its input.
+    virtual bool derivativeUsesOutput() const;
+    // gradient[i] *= the derivative at the point whose activation is output[i].
+    // Throws std::logic_error unless derivativeUsesOutput().
+    virtual void backwardFromOutputInPlace(T* gradient, const T* output, size_t count);
+    BasicMatrix<T> forward(const BasicMatrix<T>& m);
+    BasicMatrix<T> backward(const BasicMatrix<T>& upstreamGradient, const BasicMatrix<T>& activationOutput);
+    // Output-parameter variants: out must already have the input's shape and may alias
+    // an input. All matrices must have one shape; std::invalid_argument otherwise.
+    void forward(const BasicMatrix<T>& m, BasicMatrix<T>& out);
+    void backward(const BasicMatrix<T>& upstreamGradient, const BasicMatrix<T>& activationInput, BasicMatrix<T>& out);
+    // Same as backward, from the forward output instead of the input.
+    void backwardFromOutput(const BasicMatrix<T>& upstreamGradient, const BasicMatrix<T>& activationOutput, BasicMatrix<T>& out);
+    // Dense layer out = activation(weights * input + bias), bias being a column added to
+    // every column. The bias and the activation run in the GEMM epilogue on each block
+    // of out as it is finished, so out is written once. preActivation, when given, also
+    // receives weights * input + bias, for derivatives that need the input.
+    void denseForward(BasicMatrixView<T> weights, BasicMatrixView<T> input, const BasicMatrix<T>& bias,
+                      BasicMatrix<T>& out, BasicMatrix<T>* preActivation = nullptr);
     virtual std::string name() = 0;
+    // False for activations that couple the entries of each column, such as softmax.
+    // The matrix entry points above then hand them whole matrices, one sample per
+    // column, through forwardColumns() and backwardColumnsFromOutput().
+    virtual bool isElementwise() const;
+protected:
+    // values = activation(values), applied to each column as one sample.
+    virtual void forwardColumns(BasicMatrix<T>& values);
+    // gradient = J^T * gradient per column, J being the Jacobian at the point whose activation is output.
+    virtual void backwardColumnsFromOutput(BasicMatrix<T>& gradient, const BasicMatrix<T>& output);
+private:
+    void backward(const BasicMatrix<T>& upstreamGradient, const BasicMatrix<T>& cached, BasicMatrix<T>& out, bool fromOutput);
 };
 
-#endif //EDGEMLP_ACTIVATION_H
\ No newline at end of file
+using Activation = BasicActivation<double>;
+using ActivationF = BasicActivation<float>;
+
+#endif //EDGEMLP_ACTIVATION_H
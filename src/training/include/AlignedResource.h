@@ -0,0 +1,22 @@
+#ifndef EDGEMLP_ALIGNED_RESOURCE_H
+#define EDGEMLP_ALIGNED_RESOURCE_H
+
+#include <cstddef>
+#include <memory_resource>
+
+// Heap memory resource whose blocks start on a cache-line boundary, so aligned
+// SIMD loads never straddle two lines. Default storage for every Matrix.
+class AlignedResource : public std::pmr::memory_resource
+{
+public:
+    static constexpr size_t ALIGNMENT = 64;
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+// Process-wide instance; never destroyed, so it outlives every static Matrix.
+std::pmr::memory_resource* alignedResource();
+
+#endif //EDGEMLP_ALIGNED_RESOURCE_H
@@ -0,0 +1,49 @@
+#ifndef EDGEMLP_ARENA_H
+#define EDGEMLP_ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+// Bump allocator for scratch memory that lives for one training step. Allocations
+// are carved from a single buffer by advancing an offset, deallocation is a no-op
+// and reset() releases everything at once in O(1). A step that needs more than the
+// buffer holds is served from the heap; the next reset() replaces the buffer with
+// one large enough for the whole step, so the steady state never touches the heap.
+//
+// Matrices borrow storage by passing the arena as their memory resource. Anything
+// allocated from the arena must not be used after reset().
+class Arena : public std::pmr::memory_resource
+{
+public:
+    // Every block starts on a cache line, which is also enough for any SIMD load.
+    static constexpr size_t ALIGNMENT = 64;
+
+    explicit Arena(size_t initialCapacity = 0);
+    ~Arena() override;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    template<typename T>
+    T* allocateArray(const size_t count)
+    {
+        return static_cast<T*>(allocate(count * sizeof(T), ALIGNMENT));
+    }
+
+    void reset();
+    size_t capacity() const;
+    size_t used() const;
+private:
+    std::byte* buffer;
+    size_t bufferCapacity;
+    size_t offset;
+    // Heap blocks (pointer, alignment) handed out since the last reset because the buffer was full.
+    std::vector<std::pair<void*, size_t>> overflow;
+    size_t overflowBytes;
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+#endif //EDGEMLP_ARENA_H
@@ -3,12 +3,22 @@
 
 #include "Matrix.h"
 
-class Loss
+template<typename T>
+class BasicLoss
 {
 public:
-    virtual ~Loss() = default;
-    virtual double calculate(const Matrix& output, const Matrix& target) const = 0;
-    virtual Matrix derivative(const Matrix& output, const Matrix& target) const = 0;
+    virtual ~BasicLoss() = default;
+    // Outputs and targets are taken as views so dataset columns can be passed without copying.
+    virtual T calculate(BasicMatrixView<T> output, BasicMatrixView<T> target) const = 0;
+    virtual BasicMatrix<T> derivative(BasicMatrixView<T> output, BasicMatrixView<T> target) const = 0;
+    // Writes the derivative into result, which should already have the output's shape.
+    virtual void derivative(BasicMatrixView<T> output, BasicMatrixView<T> target, BasicMatrix<T>& result) const
+    {
+        result = derivative(output, target);
+    }
 };
 
-#endif //EDGEMLP_LOSS_H
\ No newline at end of file
+using Loss = BasicLoss<double>;
+using LossF = BasicLoss<float>;
+
+#endif //EDGEMLP_LOSS_H
@@ -1,34 +1,155 @@
 #ifndef EDGEMLP_MLP_H
 #define EDGEMLP_MLP_H
 
+#include <map>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "Activation.h"
+#include "Arena.h"
 #include "Loss.h"
 #include "Matrix.h"
+#include "Optimizer.h"
+#include "SparseMatrix.h"
 
-class MLP
+// How train() runs with more than one worker.
+enum class TrainingMode
+{
+    // Every step splits its batch across the workers and applies one reduced update.
+    Synchronous,
+    // Hogwild!: workers take batches from a shared counter and update the shared
+    // weights in place without locks, while other workers read and write them.
+    Hogwild
+};
+
+// Instantiated for float and double; MLP is the double version.
+template<typename T>
+class BasicMLP
 {
 public:
-    double learning_rate{};
+    using Matrix = BasicMatrix<T>;
+    using MatrixView = BasicMatrixView<T>;
+    using Activation = BasicActivation<T>;
+    using Loss = BasicLoss<T>;
+    using SparseMatrix = BasicSparseMatrix<T>;
+    using Optimizer = BasicOptimizer<T>;
+
+    T learning_rate{};
     std::shared_ptr<Loss> loss_function{};
-    MLP() = default;
-    MLP(const std::vector<int>& sizes, const std::vector<std::shared_ptr<Activation>>& activations, double learning_rate, const std::shared_ptr<Loss>& loss);
-    friend std::ostream& operator<<(std::ostream& os, const MLP& m);
-    Matrix forward(const Matrix& input);
+    // Update rule of every step, e.g. BasicAdam; plain SGD when empty. Weights of layer
+    // l use slot 2l and biases slot 2l + 1. Hogwild training supports plain SGD only.
+    std::shared_ptr<Optimizer> optimizer{};
+    BasicMLP() = default;
+    BasicMLP(const std::vector<int>& sizes, const std::vector<std::shared_ptr<Activation>>& activations, T learning_rate, const std::shared_ptr<Loss>& loss);
+    // Copies the parameters and configuration and starts from fresh buffers. The copy
+    // shares the activation, loss and optimizer objects; give it its own optimizer
+    // before training both, since optimizer state is kept per parameter slot.
+    BasicMLP(const BasicMLP& other);
+    BasicMLP& operator=(const BasicMLP& other);
+    BasicMLP(BasicMLP&& other) noexcept = default;
+    BasicMLP& operator=(BasicMLP&& other) noexcept = default;
+    template<typename U>
+    friend std::ostream& operator<<(std::ostream& os, const BasicMLP<U>& m);
+    // Inputs and targets hold one sample per column and may be views into a larger
+    // dataset matrix, e.g. X.col(i) or X.colRange(i, i + B) for a batch of B.
+    Matrix forward(MatrixView input);
+    // Sparse input, e.g. one-hot or bag-of-words features: the first layer costs
+    // time proportional to the input's nonzeros. Store batches column-major (CSC).
+    Matrix forward(const SparseMatrix& input);
+    // Zeroes every weight with magnitude <= threshold. Layers left sparse enough
+    // are then multiplied in CSR form by forward(); the next backpropagate call
+    // updates the dense weights and drops those copies, so prune after training.
+    void pruneWeights(T threshold);
     std::vector<Matrix> weights;
     std::vector<Matrix> biases;
-    void backpropagate(const Matrix& input, const Matrix& output);
-    void train(const Matrix& X, const Matrix& y, int epochs, double lr);
+    // One gradient step on a batch. The losses average over the samples, so the
+    // gradients are batch means and the learning rate does not depend on the batch size.
+    void backpropagate(MatrixView input, MatrixView output);
+    // Data-parallel step: the batch is split into `shards` column blocks whose
+    // gradients are computed concurrently on the global thread pool, each in its own
+    // workspace. A pairwise tree sums the shard gradients and one update applies
+    // them, so the step equals backpropagate() up to summation order. Shard
+    // boundaries depend only on the batch width and shards, never on the thread count.
+    void backpropagateParallel(MatrixView input, MatrixView output, int shards);
+    // One sample per column. X and y may be matrices or views of any layout, e.g.
+    // a MappedMatrix over a dataset file, which is then streamed from disk. Each step
+    // takes batch_size consecutive columns, so every layer runs as a GEMM; the last
+    // batch of an epoch may be smaller. batch_size 1 updates after every sample.
+    // Synchronous mode with workers > 1 runs each step through backpropagateParallel()
+    // with one shard per worker. Hogwild mode runs workers threads of plain steps
+    // that share the weights without synchronising: updates are applied with relaxed
+    // per-element stores, so concurrent updates of the same weight may be lost, but
+    // none is torn. Only first-layer weights of nonzero inputs are updated, which
+    // keeps workers on sparse inputs mostly out of each other's way. Results then
+    // depend on thread timing.
+    void train(MatrixView X, MatrixView y, int epochs, T lr, int batch_size = 1, int workers = 1,
+               TrainingMode mode = TrainingMode::Synchronous);
 private:
+    // Layer buffers of one batch width.
+    struct LayerBuffers
+    {
+        std::vector<Matrix> z_values;
+        std::vector<Matrix> a_values;
+    };
+    // Everything a forward and backward pass writes. The network has one for its own
+    // passes and one per shard of a data-parallel step, so shards share no buffers.
+    struct Workspace
+    {
+        // Input of the current batch, read in place by layer 0 and its weight gradient;
+        // the caller's matrix must outlive the step.
+        MatrixView input{nullptr, 0, 0, 0};
+        // Per-layer buffers, one column per sample of the current batch, rewritten by every step.
+        // a_values[0] only holds a densified sparse input, for a pruned first layer.
+        std::vector<Matrix> z_values;
+        std::vector<Matrix> a_values;
+        // Buffers of other batch widths seen recently, parked until a batch of that width
+        // comes back: an epoch alternating full batches with a smaller final one swaps
+        // buffers instead of reallocating them.
+        std::map<int, LayerBuffers> parked_buffers;
+        std::vector<Matrix> nabla_w;
+        std::vector<Matrix> nabla_b;
+        // Scratch memory for one step, reset at the end of every step.
+        Arena arena;
+        std::vector<Matrix> deltas;
+        // Inputs that are nonzero in the current batch, for the Hogwild update.
+        std::vector<int> active_inputs;
+    };
+
     std::vector<int> layer_size;
     std::vector<std::shared_ptr<Activation>> activations;
-    std::vector<Matrix> z_values;
-    std::vector<Matrix> a_values;
+    std::unique_ptr<Workspace> workspace;
+    // Created on the first data-parallel step or Hogwild epoch with that many shards or workers.
+    std::vector<std::unique_ptr<Workspace>> shard_workspaces;
+    // CSR copies of pruned weights, used instead of weights[l] while present.
+    std::vector<std::optional<SparseMatrix>> sparse_weights;
+    std::unique_ptr<Workspace> makeWorkspace() const;
+    // The network's own workspace; throws for a default-constructed or moved-from network.
+    Workspace& ownWorkspace();
+    void resizeBatch(Workspace& ws, int batch) const;
+    void feedForward(Workspace& ws, MatrixView input) const;
+    void propagateFrom(Workspace& ws, size_t layer) const;
+    // The activations feeding layer: the batch input for layer 0, else the previous layer's output.
+    MatrixView layerInput(const Workspace& ws, size_t layer) const;
+    void activateLayer(Workspace& ws, size_t layer) const;
+    void backwardActivation(Workspace& ws, size_t layer) const;
+    // ws.nabla_w and ws.nabla_b = gradientScale * the gradient of the loss on this batch.
+    // ws.deltas stay valid until releaseStepScratch(); nabla_w[0] is left out unless
+    // firstLayerWeights, for callers that apply it from the deltas themselves.
+    void computeGradients(Workspace& ws, MatrixView input, MatrixView output, T gradientScale,
+                          bool firstLayerWeights = true) const;
+    void releaseStepScratch(Workspace& ws) const;
+    void applyGradients(const Workspace& ws);
+    // Lock-free update of the shared parameters from one Hogwild worker's step.
+    void applyGradientsHogwild(Workspace& ws);
+    void trainHogwildEpoch(MatrixView X, MatrixView y, int batch_size, int workers);
 };
 
-std::ostream& operator<<(std::ostream& os, const MLP& m);
+template<typename T>
+std::ostream& operator<<(std::ostream& os, const BasicMLP<T>& m);
+
+using MLP = BasicMLP<double>;
+using MLPF = BasicMLP<float>;
 
 
 #endif //EDGEMLP_MLP_H
@@ -0,0 +1,58 @@
+#ifndef EDGEMLP_MAPPED_MATRIX_H
+#define EDGEMLP_MAPPED_MATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "MatrixView.h"
+
+// Read-only matrix backed by a memory-mapped binary file of raw T values stored
+// row-major or column-major. Nothing is read up front: the OS pages data in as it
+// is touched and drops clean pages under memory pressure, so datasets larger than
+// RAM can be trained on directly. Store samples column-major to make each X.col(i)
+// one contiguous run of the file. Views taken from the mapping must not outlive it.
+template<typename T>
+class BasicMappedMatrix
+{
+public:
+    // Maps rows x cols values starting offset bytes into the file. Throws
+    // std::runtime_error if the file cannot be opened or mapped and
+    // std::invalid_argument if it is too small for that shape.
+    BasicMappedMatrix(const std::string& path, int rows, int cols, Layout layout = Layout::RowMajor, size_t offset = 0);
+    ~BasicMappedMatrix();
+    BasicMappedMatrix(const BasicMappedMatrix&) = delete;
+    BasicMappedMatrix& operator=(const BasicMappedMatrix&) = delete;
+    BasicMappedMatrix(BasicMappedMatrix&& other) noexcept;
+    BasicMappedMatrix& operator=(BasicMappedMatrix&& other) noexcept;
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    Layout getLayout() const { return layout; }
+    const T* getData() const { return data; }
+
+    BasicMatrixView<T> view() const;
+    operator BasicMatrixView<T>() const { return view(); }
+    BasicMatrixView<T> col(int idx) const { return view().col(idx); }
+    BasicMatrixView<T> colRange(int begin, int end) const { return view().colRange(begin, end); }
+    BasicMatrixView<T> block(int row, int col, int blockRows, int blockCols) const
+    {
+        return view().block(row, col, blockRows, blockCols);
+    }
+private:
+    void* mapping;
+    size_t mappingSize;
+    const T* data;
+    int rows;
+    int cols;
+    Layout layout;
+
+    void unmap();
+};
+
+using MappedMatrix = BasicMappedMatrix<double>;
+using MappedMatrixF = BasicMappedMatrix<float>;
+using MappedMatrixI8 = BasicMappedMatrix<int8_t>;
+using MappedMatrixI32 = BasicMappedMatrix<int32_t>;
+
+#endif //EDGEMLP_MAPPED_MATRIX_H
@@ -4,42 +4,488 @@
 #include <iostream>
 #include <vector>
 #include <functional>
+#include <utility>
+#include <memory_resource>
 
-class Matrix
+#include "AlignedResource.h"
+#include "ThreadPool.h"
+#include "MatrixExpression.h"
+#include "MatrixView.h"
+#include "kernels/Gemm.h"
+
+// Dense row-major matrix over T. Matrix (double) is the default; float, int8_t
+// and int32_t are also instantiated. Products and sums accumulate in
+// kernels::accumulator_t<T>, so an int8 product is an int32 matrix.
+//
+// Storage starts on a 64-byte boundary. Rows are normally packed at cols
+// elements, but padded() and withLeadingDimension() space them ld elements
+// apart so every row starts aligned as well; the padding is zero and is never
+// read as data. getData() then points at row 0 and element (i, j) lives at
+// getData()[i * getLeadingDimension() + j].
+template<typename T>
+class BasicMatrix : public MatrixExpression<BasicMatrix<T>>
 {
+public:
+    using value_type = T;
+    using accumulator_type = kernels::accumulator_t<T>;
 private:
     int rows;
     int cols;
-    std::vector<double> data;
+    int ld;
+    std::pmr::vector<T> data;
 public:
-    Matrix(int rows, int cols);
-    ~Matrix();
-    Matrix(const Matrix& m)=default;
-    double& operator()(int row, int col);
-    double operator()(int row, int col) const;
+    BasicMatrix(int rows, int cols);
+    // Borrows storage from resource (for example an Arena) instead of the heap.
+    // Copies of such a matrix own heap storage again.
+    BasicMatrix(int rows, int cols, std::pmr::memory_resource* resource);
+    // Rows spaced ld >= cols elements apart.
+    static BasicMatrix withLeadingDimension(int rows, int cols, int ld,
+                                            std::pmr::memory_resource* resource = alignedResource());
+    // Rows padded to a whole number of cache lines, so each one starts 64-byte aligned.
+    static BasicMatrix padded(int rows, int cols, std::pmr::memory_resource* resource = alignedResource());
+    ~BasicMatrix() = default;
+    BasicMatrix(const BasicMatrix& m);
+    BasicMatrix(BasicMatrix&& m) noexcept = default;
+    template<typename E>
+    BasicMatrix(const MatrixExpression<E>& expr);
+    T& operator()(int row, int col);
+    T operator()(int row, int col) const;
 
     int getRows() const;
     int getCols() const;
-    const double* getData() const;
-    Matrix operator*(const Matrix& other) const;
-    Matrix operator+(const Matrix& other);
-    Matrix transpose();
-    Matrix hadamardProduct(const Matrix& other);
-    Matrix operator*(double scalar);
-    Matrix operator+(double scalar);
+    // Distance in elements between the starts of consecutive rows.
+    int getLeadingDimension() const { return ld; }
+    const T* getData() const;
+    T* getData();
+    BasicMatrix<accumulator_type> operator*(const BasicMatrix& other) const;
+    // this^T * other and this * other^T, reading both operands in place.
+    BasicMatrix<accumulator_type> transposeMultiply(const BasicMatrix& other) const;
+    BasicMatrix<accumulator_type> multiplyTranspose(const BasicMatrix& other) const;
+    BasicMatrix transpose();
     void randomize(double min, double max);
     void xavierInit();
     void heInit();
-    double sum() const;
+    accumulator_type sum() const;
     double mean() const;
-    Matrix sumRows() const;
-    Matrix map(const std::function<double(double)>& func) const;
-    Matrix& operator=(const Matrix& m);
-    void applyFunction(const std::function<double(double)>& func);
-    Matrix operator-(const Matrix& other);
-    Matrix operator-(const Matrix& other) const;
-    Matrix col(const int idx) const;
+    BasicMatrix<accumulator_type> sumRows() const;
+    // Writes the row sums into result, which must already be rows x 1.
+    void sumRows(BasicMatrix<accumulator_type>& result) const;
+    BasicMatrix map(const std::function<T(T)>& func) const;
+    // Callable overloads are inlined into the span loop instead of going through
+    // std::function, so simple element functions vectorize.
+    template<typename F>
+    BasicMatrix map(F&& func, Execution execution = Execution::Serial) const;
+    // result(i, j) = func((*this)(i, j), other(i, j))
+    template<typename F>
+    BasicMatrix zipMap(const BasicMatrix& other, F&& func, Execution execution = Execution::Serial) const;
+    BasicMatrix& operator=(const BasicMatrix& m) = default;
+    BasicMatrix& operator=(BasicMatrix&& m) noexcept = default;
+    template<typename E>
+    BasicMatrix& operator=(const MatrixExpression<E>& expr);
+    void applyFunction(const std::function<T(T)>& func);
+    template<typename F>
+    void applyFunction(F&& func, Execution execution = Execution::Serial);
+
+    // Non-owning slices; the matrix must outlive them and keep its shape.
+    BasicMatrixView<T> view() const;
+    operator BasicMatrixView<T>() const { return view(); }
+    BasicMatrixView<T> col(const int idx) const;
+    BasicMatrixView<T> colRange(int begin, int end) const;
+    BasicMatrixView<T> block(int row, int col, int blockRows, int blockCols) const;
+
+    // In-place variants write into this matrix's existing buffer.
+    template<typename E>
+    BasicMatrix& operator+=(const MatrixExpression<E>& other);
+    template<typename E>
+    BasicMatrix& operator-=(const MatrixExpression<E>& other);
+    BasicMatrix& operator*=(T scalar);
+    BasicMatrix& operator+=(T scalar);
+    BasicMatrix& axpy(T alpha, const BasicMatrix& x);
+    BasicMatrix& hadamardInPlace(const BasicMatrix& other);
+    // Adds a rows x 1 column to every column, e.g. a bias to each sample of a batch.
+    BasicMatrix& addToColumns(const BasicMatrix& column);
+
+    // An expiring matrix reuses its own buffer for the product instead of building an expression.
+    template<typename R>
+    BinaryExpression<BasicMatrix, R, MulOp> hadamardProduct(const MatrixExpression<R>& other) const &;
+    template<typename R>
+    BasicMatrix hadamardProduct(const MatrixExpression<R>& other) &&;
+
+    bool isContiguous() const { return ld == cols || rows <= 1; }
+    T element(const size_t index) const
+    {
+        return ld == cols ? data[index] : data[index / cols * ld + index % cols];
+    }
+    void evaluateInto(T* out) const;
+    // Matrices own their storage, and element-wise expressions read a matrix operand
+    // at the index they write, so a matrix leaf never needs a temporary.
+    bool overlaps(const T*, const T*) const { return false; }
+private:
+    void requireSameShape(int otherRows, int otherCols, const char* operation) const;
+
+    // Calls f(values, count, firstIndex) over every element, skipping the padding
+    // between rows. Large matrices are split into spans that run on the thread
+    // pool; forEachSpanInOrder keeps a single thread and element order, for
+    // callbacks with state such as a random engine.
+    template<typename F>
+    void forEachSpan(const F& f)
+    {
+        if (isContiguous())
+        {
+            ThreadPool::global().parallelFor(0, static_cast<size_t>(rows) * cols, ParallelGrain::ELEMENTWISE,
+                                             [&](const size_t first, const size_t last)
+            {
+                f(data.data() + first, last - first, first);
+            });
+            return;
+        }
+        ThreadPool::global().parallelFor(0, rows, rowsPerTask(), [&](const size_t first, const size_t last)
+        {
+            for (size_t i = first; i < last; i++)
+            {
+                f(data.data() + i * ld, size_t(cols), i * cols);
+            }
+        });
+    }
+
+    template<typename F>
+    void forEachSpanInOrder(F&& f)
+    {
+        if (isContiguous())
+        {
+            f(data.data(), static_cast<size_t>(rows) * cols, size_t(0));
+            return;
+        }
+        for (int i = 0; i < rows; i++)
+        {
+            f(data.data() + static_cast<size_t>(i) * ld, size_t(cols), static_cast<size_t>(i) * cols);
+        }
+    }
+
+    // Same as forEachSpan, pairing each span with the matching span of an equally shaped matrix.
+    // Serial when execution is Execution::Serial, in element order.
+    template<typename U, typename F>
+    void forEachSpan(const BasicMatrix<U>& other, const F& f, const Execution execution)
+    {
+        if (execution == Execution::Parallel)
+        {
+            forEachSpan(other, f);
+            return;
+        }
+        if (isContiguous() && other.isContiguous())
+        {
+            f(data.data(), other.getData(), static_cast<size_t>(rows) * cols);
+            return;
+        }
+        for (int i = 0; i < rows; i++)
+        {
+            f(data.data() + static_cast<size_t>(i) * ld,
+              other.getData() + static_cast<size_t>(i) * other.getLeadingDimension(), size_t(cols));
+        }
+    }
+
+    template<typename U, typename F>
+    void forEachSpan(const BasicMatrix<U>& other, const F& f)
+    {
+        if (isContiguous() && other.isContiguous())
+        {
+            ThreadPool::global().parallelFor(0, static_cast<size_t>(rows) * cols, ParallelGrain::ELEMENTWISE,
+                                             [&](const size_t first, const size_t last)
+            {
+                f(data.data() + first, other.getData() + first, last - first);
+            });
+            return;
+        }
+        ThreadPool::global().parallelFor(0, rows, rowsPerTask(), [&](const size_t first, const size_t last)
+        {
+            for (size_t i = first; i < last; i++)
+            {
+                f(data.data() + i * ld, other.getData() + i * other.getLeadingDimension(), size_t(cols));
+            }
+        });
+    }
+
+    size_t rowsPerTask() const
+    {
+        return ParallelGrain::ELEMENTWISE / std::max<size_t>(cols, 1) + 1;
+    }
+};
+
+using Matrix = BasicMatrix<double>;
+using MatrixF = BasicMatrix<float>;
+using MatrixI8 = BasicMatrix<int8_t>;
+using MatrixI32 = BasicMatrix<int32_t>;
+
+template<typename T>
+struct NonDeduced
+{
+    using type = T;
 };
 
-std::ostream& operator<<(std::ostream& os, const Matrix& matrix);
-#endif //EDGEMLP_MATRIX_H
\ No newline at end of file
+// C = alpha * op(A) * op(B) + beta * C into C's existing buffer, op(X) being X or X^T.
+// C must already have the result shape and must not alias A or B. Acc is
+// accumulator_t<T>, e.g. an int32 C for int8 operands. Views of either layout are
+// read in place through their leading dimension.
+template<typename T, typename Acc>
+void gemm(BasicMatrix<Acc>& C, BasicMatrixView<T> A, BasicMatrixView<T> B,
+          typename NonDeduced<Acc>::type alpha = 1, typename NonDeduced<Acc>::type beta = 0,
+          bool transA = false, bool transB = false);
+
+// C = op(A) * op(B), then the epilogue (bias, pre-activation copy, element-wise
+// function) on each block of C as soon as it is complete, while it is still in cache.
+template<typename T, typename Acc>
+void gemm(BasicMatrix<Acc>& C, BasicMatrixView<T> A, BasicMatrixView<T> B,
+          const kernels::GemmEpilogue<Acc>& epilogue, bool transA = false, bool transB = false);
+
+template<typename T, typename Acc>
+void gemm(BasicMatrix<Acc>& C, const BasicMatrix<T>& A, const BasicMatrix<T>& B,
+          const typename NonDeduced<Acc>::type alpha = 1, const typename NonDeduced<Acc>::type beta = 0,
+          const bool transA = false, const bool transB = false)
+{
+    gemm(C, A.view(), B.view(), alpha, beta, transA, transB);
+}
+
+template<typename T>
+BasicMatrix<kernels::accumulator_t<T>> operator*(BasicMatrixView<T> lhs, BasicMatrixView<T> rhs);
+
+template<typename T>
+BasicMatrix<kernels::accumulator_t<T>> operator*(const BasicMatrix<T>& lhs, const BasicMatrixView<T> rhs)
+{
+    return lhs.view() * rhs;
+}
+
+template<typename T>
+BasicMatrix<kernels::accumulator_t<T>> operator*(const BasicMatrixView<T> lhs, const BasicMatrix<T>& rhs)
+{
+    return lhs * rhs.view();
+}
+
+template<typename T>
+std::ostream& operator<<(std::ostream& os, const BasicMatrix<T>& matrix);
+
+template<typename T>
+template<typename F>
+BasicMatrix<T> BasicMatrix<T>::map(F&& func, const Execution execution) const
+{
+    BasicMatrix result(*this);
+    result.applyFunction(std::forward<F>(func), execution);
+    return result;
+}
+
+template<typename T>
+template<typename F>
+void BasicMatrix<T>::applyFunction(F&& func, const Execution execution)
+{
+    const auto apply = [&func](T* values, const size_t count, size_t)
+    {
+        for (size_t j = 0; j < count; j++)
+        {
+            values[j] = func(values[j]);
+        }
+    };
+    if (execution == Execution::Parallel)
+    {
+        forEachSpan(apply);
+    }
+    else
+    {
+        forEachSpanInOrder(apply);
+    }
+}
+
+template<typename T>
+template<typename F>
+BasicMatrix<T> BasicMatrix<T>::zipMap(const BasicMatrix& other, F&& func, const Execution execution) const
+{
+    requireSameShape(other.rows, other.cols, "zip");
+    BasicMatrix result(*this);
+    result.forEachSpan(other, [&func](T* values, const T* operand, const size_t count)
+    {
+        for (size_t j = 0; j < count; j++)
+        {
+            values[j] = func(values[j], operand[j]);
+        }
+    }, execution);
+    return result;
+}
+
+template<typename T>
+template<typename E>
+BasicMatrix<T>::BasicMatrix(const MatrixExpression<E>& expr)
+    : rows(expr.getRows()), cols(expr.getCols()), ld(cols), data(expr.size(), alignedResource())
+{
+    expr.derived().evaluateInto(data.data());
+}
+
+// Element-wise expressions read each index before writing it, so the target may appear in expr.
+// A view of the target is different: it reads other indices, or the old layout once the
+// shape changes, so expressions reading this matrix through a view go through a
+// temporary, here and in += and -=.
+template<typename T>
+template<typename E>
+BasicMatrix<T>& BasicMatrix<T>::operator=(const MatrixExpression<E>& expr)
+{
+    if (expr.derived().overlaps(data.data(), data.data() + data.size()))
+    {
+        const BasicMatrix result(expr);
+        return *this = result.view();
+    }
+    if (rows != expr.getRows() || cols != expr.getCols())
+    {
+        rows = expr.getRows();
+        cols = expr.getCols();
+        ld = cols;
+        data.resize(expr.size());
+    }
+    if (isContiguous())
+    {
+        expr.derived().evaluateInto(data.data());
+        return *this;
+    }
+    const E& source = expr.derived();
+    forEachSpan([&source](T* out, const size_t count, const size_t first)
+    {
+        for (size_t j = 0; j < count; j++)
+        {
+            out[j] = source.element(first + j);
+        }
+    });
+    return *this;
+}
+
+template<typename T>
+template<typename E>
+BasicMatrix<T>& BasicMatrix<T>::operator+=(const MatrixExpression<E>& other)
+{
+    requireSameShape(other.getRows(), other.getCols(), "add");
+    if (other.derived().overlaps(data.data(), data.data() + data.size()))
+    {
+        const BasicMatrix operand(other);
+        return *this += operand;
+    }
+    if constexpr (std::is_same_v<E, BasicMatrix>)
+    {
+        const auto& kernel = kernels::elementwise<T>();
+        forEachSpan(other.derived(), [&kernel](T* values, const T* operand, const size_t count)
+        {
+            kernel.add(values, operand, values, count);
+        });
+    }
+    else
+    {
+        const E& expr = other.derived();
+        forEachSpan([&expr](T* values, const size_t count, const size_t first)
+        {
+            for (size_t j = 0; j < count; j++)
+            {
+                values[j] = static_cast<T>(values[j] + expr.element(first + j));
+            }
+        });
+    }
+    return *this;
+}
+
+template<typename T>
+template<typename E>
+BasicMatrix<T>& BasicMatrix<T>::operator-=(const MatrixExpression<E>& other)
+{
+    requireSameShape(other.getRows(), other.getCols(), "subtract");
+    if (other.derived().overlaps(data.data(), data.data() + data.size()))
+    {
+        const BasicMatrix operand(other);
+        return *this -= operand;
+    }
+    if constexpr (std::is_same_v<E, BasicMatrix>)
+    {
+        const auto& kernel = kernels::elementwise<T>();
+        forEachSpan(other.derived(), [&kernel](T* values, const T* operand, const size_t count)
+        {
+            kernel.sub(values, operand, values, count);
+        });
+    }
+    else
+    {
+        const E& expr = other.derived();
+        forEachSpan([&expr](T* values, const size_t count, const size_t first)
+        {
+            for (size_t j = 0; j < count; j++)
+            {
+                values[j] = static_cast<T>(values[j] - expr.element(first + j));
+            }
+        });
+    }
+    return *this;
+}
+
+template<typename T>
+template<typename R>
+BinaryExpression<BasicMatrix<T>, R, MulOp> BasicMatrix<T>::hadamardProduct(const MatrixExpression<R>& other) const &
+{
+    return MatrixExpression<BasicMatrix>::hadamardProduct(other);
+}
+
+template<typename T>
+template<typename R>
+BasicMatrix<T> BasicMatrix<T>::hadamardProduct(const MatrixExpression<R>& other) &&
+{
+    *this = BinaryExpression<BasicMatrix, R, MulOp>(*this, other.derived());
+    return std::move(*this);
+}
+
+// Rvalue overloads: an expiring Matrix operand donates its buffer to the result,
+// so chains such as (w * a) + b allocate only for the product.
+template<typename T, typename R>
+BasicMatrix<T> operator+(BasicMatrix<T>&& lhs, const MatrixExpression<R>& rhs)
+{
+    lhs = BinaryExpression<BasicMatrix<T>, R, AddOp>(lhs, rhs.derived());
+    return std::move(lhs);
+}
+
+template<typename L, typename T>
+BasicMatrix<T> operator+(const MatrixExpression<L>& lhs, BasicMatrix<T>&& rhs)
+{
+    rhs = BinaryExpression<L, BasicMatrix<T>, AddOp>(lhs.derived(), rhs);
+    return std::move(rhs);
+}
+
+template<typename T>
+BasicMatrix<T> operator+(BasicMatrix<T>&& lhs, BasicMatrix<T>&& rhs)
+{
+    return std::move(lhs) + static_cast<const BasicMatrix<T>&>(rhs);
+}
+
+template<typename T, typename R>
+BasicMatrix<T> operator-(BasicMatrix<T>&& lhs, const MatrixExpression<R>& rhs)
+{
+    lhs = BinaryExpression<BasicMatrix<T>, R, SubOp>(lhs, rhs.derived());
+    return std::move(lhs);
+}
+
+template<typename L, typename T>
+BasicMatrix<T> operator-(const MatrixExpression<L>& lhs, BasicMatrix<T>&& rhs)
+{
+    rhs = BinaryExpression<L, BasicMatrix<T>, SubOp>(lhs.derived(), rhs);
+    return std::move(rhs);
+}
+
+template<typename T>
+BasicMatrix<T> operator-(BasicMatrix<T>&& lhs, BasicMatrix<T>&& rhs)
+{
+    return std::move(lhs) - static_cast<const BasicMatrix<T>&>(rhs);
+}
+
+template<typename T>
+BasicMatrix<T> operator*(BasicMatrix<T>&& m, const typename NonDeduced<T>::type scalar)
+{
+    m *= scalar;
+    return std::move(m);
+}
+
+template<typename T>
+BasicMatrix<T> operator+(BasicMatrix<T>&& m, const typename NonDeduced<T>::type scalar)
+{
+    m += scalar;
+    return std::move(m);
+}
+
+#endif //EDGEMLP_MATRIX_H
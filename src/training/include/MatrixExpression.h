@@ -0,0 +1,227 @@
+#ifndef EDGEMLP_MATRIX_EXPRESSION_H
+#define EDGEMLP_MATRIX_EXPRESSION_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "ThreadPool.h"
+#include "kernels/Elementwise.h"
+
+// Lazy element-wise arithmetic. Operators on matrices build lightweight expression
+// nodes that are evaluated in a single loop when assigned to a Matrix, so
+// `A - B * s + C` needs no intermediate buffers. Nodes hold references to Matrix
+// operands: assign an expression to a Matrix before the statement ends.
+// Both operands of a node must share one element type.
+
+template<typename T>
+class BasicMatrix;
+template<typename T>
+class BasicMatrixView;
+struct MulOp;
+
+template<typename E>
+struct IsMatrix : std::false_type
+{
+};
+
+template<typename T>
+struct IsMatrix<BasicMatrix<T>> : std::true_type
+{
+};
+
+template<typename E>
+inline constexpr bool isMatrix = IsMatrix<E>::value;
+
+// Leaves backed by memory (matrices and views); these can hand a kernel a flat
+// buffer whenever their isContiguous() holds.
+template<typename E>
+struct IsDense : IsMatrix<E>
+{
+};
+
+template<typename T>
+struct IsDense<BasicMatrixView<T>> : std::true_type
+{
+};
+
+template<typename E>
+inline constexpr bool isDense = IsDense<E>::value;
+
+template<typename L, typename R, typename Op>
+class BinaryExpression;
+
+template<typename E>
+class MatrixExpression
+{
+public:
+    const E& derived() const { return static_cast<const E&>(*this); }
+    int getRows() const { return derived().getRows(); }
+    int getCols() const { return derived().getCols(); }
+    size_t size() const { return static_cast<size_t>(getRows()) * getCols(); }
+
+    template<typename R>
+    BinaryExpression<E, R, MulOp> hadamardProduct(const MatrixExpression<R>& other) const;
+};
+
+struct AddOp
+{
+    static constexpr const char* VERB = "add";
+    template<typename T>
+    static auto kernel() { return kernels::elementwise<T>().add; }
+    template<typename T>
+    static auto scalarKernel() { return kernels::elementwise<T>().addScalar; }
+    template<typename T>
+    static T apply(const T a, const T b) { return static_cast<T>(a + b); }
+};
+
+struct SubOp
+{
+    static constexpr const char* VERB = "subtract";
+    template<typename T>
+    static auto kernel() { return kernels::elementwise<T>().sub; }
+    template<typename T>
+    static T apply(const T a, const T b) { return static_cast<T>(a - b); }
+};
+
+struct MulOp
+{
+    static constexpr const char* VERB = "perform Hadamard product on";
+    template<typename T>
+    static auto kernel() { return kernels::elementwise<T>().mul; }
+    template<typename T>
+    static auto scalarKernel() { return kernels::elementwise<T>().scale; }
+    template<typename T>
+    static T apply(const T a, const T b) { return static_cast<T>(a * b); }
+};
+
+// Matrix operands are captured by reference, nested expressions by value.
+template<typename E>
+using ExpressionOperand = std::conditional_t<isMatrix<E>, const E&, const E>;
+
+template<typename L, typename R, typename Op>
+class BinaryExpression : public MatrixExpression<BinaryExpression<L, R, Op>>
+{
+private:
+    ExpressionOperand<L> lhs;
+    ExpressionOperand<R> rhs;
+public:
+    using value_type = typename L::value_type;
+    static_assert(std::is_same_v<value_type, typename R::value_type>,
+                  "Element-wise operands must have the same element type");
+
+    BinaryExpression(const L& lhs, const R& rhs) : lhs(lhs), rhs(rhs)
+    {
+        if (lhs.getRows() != rhs.getRows() || lhs.getCols() != rhs.getCols())
+        {
+            throw std::invalid_argument(
+                std::string("Cannot ") + Op::VERB + " matrices with incompatible dimensions " +
+                std::to_string(lhs.getRows()) + "x" + std::to_string(lhs.getCols()) + " and " +
+                std::to_string(rhs.getRows()) + "x" + std::to_string(rhs.getCols()));
+        }
+    }
+
+    int getRows() const { return lhs.getRows(); }
+    int getCols() const { return lhs.getCols(); }
+    value_type element(const size_t index) const { return Op::apply(lhs.element(index), rhs.element(index)); }
+    bool overlaps(const value_type* begin, const value_type* end) const
+    {
+        return lhs.overlaps(begin, end) || rhs.overlaps(begin, end);
+    }
+
+    void evaluateInto(value_type* out) const
+    {
+        ThreadPool::global().parallelFor(0, this->size(), ParallelGrain::ELEMENTWISE,
+                                         [this, out](const size_t first, const size_t last)
+        {
+            if constexpr (isDense<L> && isDense<R>)
+            {
+                // Leaf-only expressions over flat buffers map onto one SIMD kernel call per span
+                if (lhs.isContiguous() && rhs.isContiguous())
+                {
+                    Op::template kernel<value_type>()(lhs.getData() + first, rhs.getData() + first, out + first,
+                                                      last - first);
+                    return;
+                }
+            }
+            for (size_t i = first; i < last; i++)
+            {
+                out[i] = element(i);
+            }
+        });
+    }
+};
+
+template<typename E, typename Op>
+class ScalarExpression : public MatrixExpression<ScalarExpression<E, Op>>
+{
+public:
+    using value_type = typename E::value_type;
+private:
+    ExpressionOperand<E> expr;
+    value_type scalar;
+public:
+    ScalarExpression(const E& expr, const value_type scalar) : expr(expr), scalar(scalar)
+    {
+    }
+
+    int getRows() const { return expr.getRows(); }
+    int getCols() const { return expr.getCols(); }
+    value_type element(const size_t index) const { return Op::apply(expr.element(index), scalar); }
+    bool overlaps(const value_type* begin, const value_type* end) const { return expr.overlaps(begin, end); }
+
+    void evaluateInto(value_type* out) const
+    {
+        ThreadPool::global().parallelFor(0, this->size(), ParallelGrain::ELEMENTWISE,
+                                         [this, out](const size_t first, const size_t last)
+        {
+            if constexpr (isDense<E>)
+            {
+                if (expr.isContiguous())
+                {
+                    Op::template scalarKernel<value_type>()(expr.getData() + first, scalar, out + first,
+                                                            last - first);
+                    return;
+                }
+            }
+            for (size_t i = first; i < last; i++)
+            {
+                out[i] = element(i);
+            }
+        });
+    }
+};
+
+template<typename E>
+template<typename R>
+BinaryExpression<E, R, MulOp> MatrixExpression<E>::hadamardProduct(const MatrixExpression<R>& other) const
+{
+    return BinaryExpression<E, R, MulOp>(derived(), other.derived());
+}
+
+template<typename L, typename R>
+BinaryExpression<L, R, AddOp> operator+(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+{
+    return BinaryExpression<L, R, AddOp>(lhs.derived(), rhs.derived());
+}
+
+template<typename L, typename R>
+BinaryExpression<L, R, SubOp> operator-(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+{
+    return BinaryExpression<L, R, SubOp>(lhs.derived(), rhs.derived());
+}
+
+template<typename E>
+ScalarExpression<E, MulOp> operator*(const MatrixExpression<E>& expr, const typename E::value_type scalar)
+{
+    return ScalarExpression<E, MulOp>(expr.derived(), scalar);
+}
+
+template<typename E>
+ScalarExpression<E, AddOp> operator+(const MatrixExpression<E>& expr, const typename E::value_type scalar)
+{
+    return ScalarExpression<E, AddOp>(expr.derived(), scalar);
+}
+
+#endif //EDGEMLP_MATRIX_EXPRESSION_H
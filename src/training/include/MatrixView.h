@@ -0,0 +1,89 @@
+#ifndef EDGEMLP_MATRIX_VIEW_H
+#define EDGEMLP_MATRIX_VIEW_H
+
+#include <cstddef>
+#include <functional>
+
+#include "MatrixExpression.h"
+
+enum class Layout
+{
+    RowMajor,
+    ColumnMajor
+};
+
+// Read-only window into dense storage: rows x cols elements starting at data.
+// Row-major views keep consecutive rows ld elements apart; column-major views
+// keep consecutive columns ld elements apart. Views do not own their elements,
+// so the storage they were taken from must outlive them. Columns, column ranges
+// and blocks of a view are views again, so slicing never copies.
+template<typename T>
+class BasicMatrixView : public MatrixExpression<BasicMatrixView<T>>
+{
+private:
+    const T* data;
+    int rows;
+    int cols;
+    int ld;
+    Layout layout;
+public:
+    using value_type = T;
+
+    BasicMatrixView(const T* data, int rows, int cols, int ld, Layout layout = Layout::RowMajor)
+        : data(data), rows(rows), cols(cols), ld(ld), layout(layout)
+    {
+    }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    // Distance in elements between the starts of consecutive rows (columns when column-major).
+    int getLeadingDimension() const { return ld; }
+    Layout getLayout() const { return layout; }
+    const T* getData() const { return data; }
+    // True when the elements sit back to back in row-major order.
+    bool isContiguous() const
+    {
+        return layout == Layout::RowMajor ? ld == cols || rows <= 1 : cols <= 1 || (rows <= 1 && ld == 1);
+    }
+    T operator()(const int row, const int col) const
+    {
+        return layout == Layout::RowMajor ? data[static_cast<size_t>(row) * ld + col]
+                                          : data[static_cast<size_t>(col) * ld + row];
+    }
+
+    // The same elements seen as the transposed matrix, which flips the layout.
+    BasicMatrixView transposed() const;
+
+    BasicMatrixView col(int idx) const;
+    BasicMatrixView colRange(int begin, int end) const;
+    BasicMatrixView block(int row, int col, int blockRows, int blockCols) const;
+
+    T element(const size_t index) const
+    {
+        if (layout == Layout::ColumnMajor)
+        {
+            return (*this)(static_cast<int>(index / cols), static_cast<int>(index % cols));
+        }
+        return cols == 1 ? data[index * ld] : data[index / cols * ld + index % cols];
+    }
+
+    void evaluateInto(T* out) const;
+    // True when any element of the view lies in [begin, end).
+    bool overlaps(const T* begin, const T* end) const
+    {
+        if (rows == 0 || cols == 0)
+        {
+            return false;
+        }
+        const size_t extent = layout == Layout::RowMajor ? static_cast<size_t>(rows - 1) * ld + cols
+                                                         : static_cast<size_t>(cols - 1) * ld + rows;
+        return std::less<const T*>()(data, end) && std::less<const T*>()(begin, data + extent);
+    }
+};
+
+using MatrixView = BasicMatrixView<double>;
+using MatrixViewF = BasicMatrixView<float>;
+using MatrixViewI8 = BasicMatrixView<int8_t>;
+using MatrixViewI32 = BasicMatrixView<int32_t>;
+
+#endif //EDGEMLP_MATRIX_VIEW_H
@@ -0,0 +1,42 @@
+#ifndef EDGEMLP_OPTIMIZER_H
+#define EDGEMLP_OPTIMIZER_H
+
+#include <string>
+#include <vector>
+
+#include "Matrix.h"
+
+// Update rule that turns a gradient into a parameter step. Each parameter matrix
+// has a slot, and each slot has state buffers such as velocities or moment
+// estimates, with the parameters' shape. A buffer is created zeroed the first time
+// its slot is updated. An update is one fused pass that reads the gradient and the
+// state once and writes the parameters and the state in place.
+template<typename T>
+class BasicOptimizer
+{
+public:
+    // Upper bound of stateCount().
+    static constexpr size_t MAX_STATE_BUFFERS = 2;
+
+    virtual ~BasicOptimizer() = default;
+    // Called once per step, before that step's updates, e.g. to advance a step counter.
+    virtual void beginStep() {}
+    // parameters -= the step for gradient, which must have the parameters' shape.
+    // slot identifies the parameter matrix from one step to the next.
+    void update(size_t slot, BasicMatrix<T>& parameters, const BasicMatrix<T>& gradient, T learningRate);
+    // Drops the state of every slot, e.g. before training a re-initialised network.
+    virtual void reset();
+    virtual std::string name() const = 0;
+protected:
+    // Number of state buffers per slot, at most MAX_STATE_BUFFERS.
+    virtual size_t stateCount() const = 0;
+    // Updates count consecutive parameters; state[k] points at the matching elements of buffer k.
+    virtual void updateSpan(T* parameters, T* const* state, const T* gradient, size_t count, T learningRate) const = 0;
+private:
+    std::vector<std::vector<BasicMatrix<T>>> slots;
+};
+
+using Optimizer = BasicOptimizer<double>;
+using OptimizerF = BasicOptimizer<float>;
+
+#endif //EDGEMLP_OPTIMIZER_H
@@ -0,0 +1,76 @@
+#ifndef EDGEMLP_SPARSE_MATRIX_H
+#define EDGEMLP_SPARSE_MATRIX_H
+
+#include <vector>
+
+#include "Matrix.h"
+#include "MatrixView.h"
+#include "kernels/Sparse.h"
+
+// Sparse matrix in compressed form: CSR for Layout::RowMajor, CSC for
+// Layout::ColumnMajor. Only the nonzeros are stored, so products with dense
+// matrices cost time and bandwidth proportional to nonZeros(). Use CSR for
+// sparse weights (W * a) and CSC for a batch of sparse input columns (W * X).
+template<typename T>
+class BasicSparseMatrix
+{
+private:
+    int rows;
+    int cols;
+    Layout layout;
+    // Slice s of the compressed dimension (a row for CSR, a column for CSC) holds
+    // values[pointers[s] .. pointers[s + 1]) at ascending positions indices[...].
+    std::vector<int> pointers;
+    std::vector<int> indices;
+    std::vector<T> values;
+public:
+    using value_type = T;
+
+    // All-zero matrix.
+    BasicSparseMatrix(int rows, int cols, Layout layout = Layout::RowMajor);
+    // Keeps the entries of dense whose magnitude exceeds threshold, e.g. to prune weights.
+    explicit BasicSparseMatrix(BasicMatrixView<T> dense, Layout layout = Layout::RowMajor, T threshold = 0);
+    // Takes ownership of compressed arrays; throws std::invalid_argument if they are inconsistent.
+    BasicSparseMatrix(int rows, int cols, std::vector<int> pointers, std::vector<int> indices, std::vector<T> values,
+                      Layout layout = Layout::RowMajor);
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    Layout getLayout() const { return layout; }
+    size_t nonZeros() const { return values.size(); }
+    double density() const;
+    const std::vector<int>& getPointers() const { return pointers; }
+    const std::vector<int>& getIndices() const { return indices; }
+    const std::vector<T>& getValues() const { return values; }
+    kernels::Csr<T> compressed() const { return {pointers.data(), indices.data(), values.data()}; }
+
+    T operator()(int row, int col) const;
+    BasicMatrix<T> toDense() const;
+    // Reinterprets the same arrays: the transpose of a CSR matrix is CSC and vice versa.
+    BasicSparseMatrix transposed() const;
+};
+
+using SparseMatrix = BasicSparseMatrix<double>;
+using SparseMatrixF = BasicSparseMatrix<float>;
+using SparseMatrixI8 = BasicSparseMatrix<int8_t>;
+using SparseMatrixI32 = BasicSparseMatrix<int32_t>;
+
+// C = alpha * A * B + beta * C with one sparse operand, into C's existing buffer.
+// Dense operands may be matrices or views of either layout.
+template<typename T, typename Acc>
+void gemm(BasicMatrix<Acc>& C, const BasicSparseMatrix<T>& A, typename NonDeduced<BasicMatrixView<T>>::type B,
+          typename NonDeduced<Acc>::type alpha = 1, typename NonDeduced<Acc>::type beta = 0);
+
+template<typename T, typename Acc>
+void gemm(BasicMatrix<Acc>& C, typename NonDeduced<BasicMatrixView<T>>::type A, const BasicSparseMatrix<T>& B,
+          typename NonDeduced<Acc>::type alpha = 1, typename NonDeduced<Acc>::type beta = 0);
+
+template<typename T>
+BasicMatrix<kernels::accumulator_t<T>> operator*(const BasicSparseMatrix<T>& lhs,
+                                                  typename NonDeduced<BasicMatrixView<T>>::type rhs);
+
+template<typename T>
+BasicMatrix<kernels::accumulator_t<T>> operator*(typename NonDeduced<BasicMatrixView<T>>::type lhs,
+                                                  const BasicSparseMatrix<T>& rhs);
+
+#endif //EDGEMLP_SPARSE_MATRIX_H
@@ -0,0 +1,150 @@
+#ifndef EDGEMLP_THREAD_POOL_H
+#define EDGEMLP_THREAD_POOL_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Minimum work per parallel task for each kind of operation. An operation with
+// less than two tasks' worth of work runs serially on the calling thread, so the
+// tiny products of a {2,3,1} network never pay for waking the pool.
+struct ParallelGrain
+{
+    static constexpr size_t GEMM_FLOPS = size_t(1) << 16; // multiply-adds
+    static constexpr size_t ELEMENTWISE = size_t(1) << 15; // elements
+    static constexpr size_t REDUCTION = size_t(1) << 15;   // elements
+    static constexpr size_t TRANSPOSE = size_t(1) << 14;   // elements
+};
+
+// Execution policy for loops that run a caller-supplied callable. Parallel splits
+// the loop across the global pool, so the callable must be safe to call
+// concurrently and must not depend on the order in which elements are visited.
+enum class Execution
+{
+    Serial,
+    Parallel
+};
+
+// Persistent worker threads shared by every Matrix kernel. A parallel loop splits
+// its range into chunks that the caller and the workers claim from a shared
+// counter; the caller returns once every chunk has run. Loops started from inside
+// a chunk, or while another thread is using the pool, run serially, so nesting
+// never deadlocks. When a loop body throws, chunks not yet started are skipped and
+// the first exception is rethrown to the caller once every running chunk is done.
+class ThreadPool
+{
+public:
+    // Total threads including the caller; threads <= 1 runs everything inline.
+    explicit ThreadPool(int threads);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Shared pool, created on first use with defaultThreadCount() threads; safe to
+    // call from several threads at once.
+    static ThreadPool& global();
+    // Rebuilds the shared pool; 0 restores the default. Unlike global(), this must not
+    // race with running kernels or with other calls to it.
+    static void setGlobalThreadCount(int threads);
+    // EDGEMLP_NUM_THREADS from the environment, then the build setting of the same
+    // name, then one thread per hardware core.
+    static int defaultThreadCount();
+
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    // Calls body(chunkBegin, chunkEnd) over disjoint chunks covering [begin, end),
+    // each at least grain long.
+    template<typename F>
+    void parallelFor(const size_t begin, const size_t end, const size_t grain, const F& body)
+    {
+        const size_t n = end > begin ? end - begin : 0;
+        const size_t chunks = std::min(n / std::max<size_t>(grain, 1), static_cast<size_t>(size()) * CHUNKS_PER_THREAD);
+        if (chunks <= 1)
+        {
+            if (n > 0)
+                body(begin, end);
+            return;
+        }
+        const size_t step = (n + chunks - 1) / chunks;
+        const auto task = [&](const size_t c)
+        {
+            const size_t first = begin + c * step;
+            const size_t last = std::min(end, first + step);
+            if (first < last)
+                body(first, last);
+        };
+        run(&invoke<decltype(task)>, &task, chunks);
+    }
+
+    // Combines chunk(chunkBegin, chunkEnd) over [begin, end) in order, starting from
+    // identity. The chunking depends only on the range and grain, never on the
+    // thread count, so floating-point results are reproducible on any machine.
+    template<typename T, typename F, typename C>
+    T parallelReduce(const size_t begin, const size_t end, const size_t grain, const T identity, const F& chunk,
+                     const C& combine)
+    {
+        const size_t n = end > begin ? end - begin : 0;
+        const size_t chunks = std::min(n / std::max<size_t>(grain, 1), MAX_REDUCE_CHUNKS);
+        if (chunks <= 1)
+        {
+            return n > 0 ? combine(identity, chunk(begin, end)) : identity;
+        }
+        const size_t step = (n + chunks - 1) / chunks;
+        std::array<T, MAX_REDUCE_CHUNKS> partial{};
+        const auto task = [&](const size_t c)
+        {
+            const size_t first = begin + c * step;
+            const size_t last = std::min(end, first + step);
+            partial[c] = first < last ? chunk(first, last) : identity;
+        };
+        run(&invoke<decltype(task)>, &task, chunks);
+        T result = identity;
+        for (size_t c = 0; c < chunks; c++)
+        {
+            result = combine(result, partial[c]);
+        }
+        return result;
+    }
+private:
+    // More chunks than threads evens out chunks that finish at different speeds.
+    static constexpr size_t CHUNKS_PER_THREAD = 4;
+    static constexpr size_t MAX_REDUCE_CHUNKS = 64;
+
+    using Task = void (*)(const void* context, size_t index);
+
+    std::vector<std::thread> workers;
+    std::mutex submitMutex;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    // Current job, only rewritten while no worker is inside it.
+    Task task = nullptr;
+    const void* context = nullptr;
+    size_t taskCount = 0;
+    std::atomic<size_t> nextTask{0};
+    // First exception thrown by a chunk of the current job.
+    std::exception_ptr error = nullptr;
+    size_t generation = 0;
+    int active = 0;
+    bool stopping = false;
+
+    template<typename F>
+    static void invoke(const void* f, const size_t index)
+    {
+        (*static_cast<const F*>(f))(index);
+    }
+
+    // Runs task(context, i) for i in [0, count) and waits for all of them.
+    void run(Task task, const void* context, size_t count);
+    void drain();
+    void workerLoop();
+};
+
+#endif //EDGEMLP_THREAD_POOL_H
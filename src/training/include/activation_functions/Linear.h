@@ -3,13 +3,21 @@
 
 #include "../Activation.h"
 
-class Linear: public Activation
+template<typename T>
+class BasicLinear: public BasicActivation<T>
 {
 public:
-    double activate(double x) override;
-    double derivative(double x) override;
+    T activate(T x) override;
+    T derivative(T x) override;
+    void forwardInPlace(T* values, size_t count) override;
+    void backwardInPlace(T* gradient, const T* input, size_t count) override;
+    bool derivativeUsesOutput() const override;
+    void backwardFromOutputInPlace(T* gradient, const T* output, size_t count) override;
     std::string name() override;
 };
 
+using Linear = BasicLinear<double>;
+using LinearF = BasicLinear<float>;
+
 
 #endif //EDGEMLP_LINEAR_H
\ No newline at end of file
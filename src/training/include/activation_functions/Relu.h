@@ -3,13 +3,21 @@
 
 #include "../Activation.h"
 
-class Relu: public Activation
+template<typename T>
+class BasicRelu: public BasicActivation<T>
 {
 public:
-    double activate(double x) override;
-    double derivative(double x) override;
+    T activate(T x) override;
+    T derivative(T x) override;
+    void forwardInPlace(T* values, size_t count) override;
+    void backwardInPlace(T* gradient, const T* input, size_t count) override;
+    bool derivativeUsesOutput() const override;
+    void backwardFromOutputInPlace(T* gradient, const T* output, size_t count) override;
     std::string name() override;
 };
 
+using Relu = BasicRelu<double>;
+using ReluF = BasicRelu<float>;
+
 
 #endif //EDGEMLP_RELU_H
\ No newline at end of file
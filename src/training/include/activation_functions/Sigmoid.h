@@ -3,13 +3,25 @@
 
 #include "../Activation.h"
 
-class Sigmoid: public Activation
+template<typename T>
+class BasicSigmoid: public BasicActivation<T>
 {
 public:
-    double activate(double x) override;
-    double derivative(double x) override;
+    explicit BasicSigmoid(ActivationPrecision precision = ActivationPrecision::Exact);
+    ActivationPrecision getPrecision() const;
+    T activate(T x) override;
+    T derivative(T x) override;
+    void forwardInPlace(T* values, size_t count) override;
+    void backwardInPlace(T* gradient, const T* input, size_t count) override;
+    bool derivativeUsesOutput() const override;
+    void backwardFromOutputInPlace(T* gradient, const T* output, size_t count) override;
     std::string name() override;
+private:
+    ActivationPrecision precision;
 };
 
+using Sigmoid = BasicSigmoid<double>;
+using SigmoidF = BasicSigmoid<float>;
+
 
 #endif //EDGEMLP_SIGMOID_H
\ No newline at end of file
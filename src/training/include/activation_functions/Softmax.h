@@ -0,0 +1,40 @@
+#ifndef EDGEMLP_SOFTMAX_H
+#define EDGEMLP_SOFTMAX_H
+
+#include "../Activation.h"
+
+// softmax(z)_i = exp(z_i - max(z)) / sum_j exp(z_j - max(z)), normalised over each
+// column of a matrix (one sample per column) and over the whole buffer in the
+// *InPlace variants. Subtracting the maximum keeps exp from overflowing. Softmax
+// has no scalar form, so activate() and derivative() throw std::logic_error.
+// Paired with BasicCrossEntropy as the output layer, the MLP skips the Jacobian
+// altogether and uses the fused p - y gradient.
+template<typename T>
+class BasicSoftmax: public BasicActivation<T>
+{
+public:
+    explicit BasicSoftmax(ActivationPrecision precision = ActivationPrecision::Exact);
+    ActivationPrecision getPrecision() const;
+    T activate(T x) override;
+    T derivative(T x) override;
+    void forwardInPlace(T* values, size_t count) override;
+    void backwardInPlace(T* gradient, const T* input, size_t count) override;
+    bool derivativeUsesOutput() const override;
+    // gradient = p * (gradient - dot(gradient, p)), the Jacobian-vector product at p = output.
+    void backwardFromOutputInPlace(T* gradient, const T* output, size_t count) override;
+    bool isElementwise() const override;
+    std::string name() override;
+protected:
+    void forwardColumns(BasicMatrix<T>& values) override;
+    void backwardColumnsFromOutput(BasicMatrix<T>& gradient, const BasicMatrix<T>& output) override;
+private:
+    ActivationPrecision precision;
+
+    void expInPlace(T* values, size_t count) const;
+};
+
+using Softmax = BasicSoftmax<double>;
+using SoftmaxF = BasicSoftmax<float>;
+
+
+#endif //EDGEMLP_SOFTMAX_H
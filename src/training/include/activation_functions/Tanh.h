@@ -1,15 +1,27 @@
 #ifndef EDGEMLP_TANH_H
 #define EDGEMLP_TANH_H
 
-#include "Activation.h"
+#include "../Activation.h"
 
-class Tanh: public Activation
+template<typename T>
+class BasicTanh: public BasicActivation<T>
 {
 public:
-    double activate(double x) override;
-    double derivative(double x) override;
+    explicit BasicTanh(ActivationPrecision precision = ActivationPrecision::Exact);
+    ActivationPrecision getPrecision() const;
+    T activate(T x) override;
+    T derivative(T x) override;
+    void forwardInPlace(T* values, size_t count) override;
+    void backwardInPlace(T* gradient, const T* input, size_t count) override;
+    bool derivativeUsesOutput() const override;
+    void backwardFromOutputInPlace(T* gradient, const T* output, size_t count) override;
     std::string name() override;
+private:
+    ActivationPrecision precision;
 };
 
+using Tanh = BasicTanh<double>;
+using TanhF = BasicTanh<float>;
+
 
 #endif //EDGEMLP_TANH_H
\ No newline at end of file
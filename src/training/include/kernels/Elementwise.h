@@ -0,0 +1,110 @@
+#ifndef EDGEMLP_ELEMENTWISE_H
+#define EDGEMLP_ELEMENTWISE_H
+
+#include <cstddef>
+#include <cstdint>
+
+// x86 SIMD paths are compiled with per-function target attributes, so the
+// library itself needs no -mavx flags and still runs on CPUs without them.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define EDGEMLP_X86_SIMD 1
+#endif
+
+namespace kernels
+{
+    // Type that sums and dot products of T accumulate into: int8 widens to int32 so
+    // quantized products do not overflow, every other type accumulates in itself.
+    template<typename T>
+    struct Accumulator
+    {
+        using type = T;
+    };
+
+    template<>
+    struct Accumulator<int8_t>
+    {
+        using type = int32_t;
+    };
+
+    template<typename T>
+    using accumulator_t = typename Accumulator<T>::type;
+
+    enum class Isa
+    {
+        Scalar,
+        Avx2,
+        Avx512
+    };
+
+    // Hyperparameters of one fused Adam step, with the bias corrections of step t folded in.
+    template<typename T>
+    struct AdamStep
+    {
+        T beta1;
+        T beta2;
+        // learning rate / (1 - beta1^t)
+        T stepSize;
+        // 1 / (1 - beta2^t)
+        T secondMomentScale;
+        T epsilon;
+        // learning rate * weight decay, decoupled from the gradient as in AdamW; 0 for Adam
+        T decay;
+    };
+
+    // Flat-buffer kernels behind Matrix element-wise operations. Output may alias an input.
+    // float and double have SIMD variants; integer types always use the scalar path.
+    template<typename T>
+    struct ElementwiseKernels
+    {
+        Isa isa;
+        void (*add)(const T* a, const T* b, T* out, size_t n);
+        void (*sub)(const T* a, const T* b, T* out, size_t n);
+        void (*mul)(const T* a, const T* b, T* out, size_t n);
+        void (*scale)(const T* a, T scalar, T* out, size_t n);
+        void (*addScalar)(const T* a, T scalar, T* out, size_t n);
+        accumulator_t<T> (*sum)(const T* a, size_t n);
+        // y += alpha * x
+        void (*axpy)(T alpha, const T* x, T* y, size_t n);
+        // out = a <= 0 ? 0 : a
+        void (*relu)(const T* a, T* out, size_t n);
+        // out = a <= 0 ? 0 : grad, the ReLU derivative applied to an upstream gradient
+        void (*reluBackward)(const T* a, const T* grad, T* out, size_t n);
+        // Approximate exp, sigmoid and tanh for ActivationPrecision::Fast, with the error
+        // bounds documented in FastMath.h. nullptr for integer types.
+        void (*fastExp)(const T* a, T* out, size_t n);
+        void (*fastSigmoid)(const T* a, T* out, size_t n);
+        void (*fastTanh)(const T* a, T* out, size_t n);
+        // Fused optimizer updates that read the gradient and state and write the
+        // parameters p and state in place, one pass each; the scalar forms are in
+        // OptimizerMath.h. nullptr for integer types.
+        // velocity = beta * velocity + g, then p -= lr * velocity, or
+        // p -= lr * (g + beta * velocity) when nesterov
+        void (*momentumStep)(T* p, T* velocity, const T* g, T lr, T beta, bool nesterov, size_t n);
+        // m = beta1 * m + (1 - beta1) * g, v = beta2 * v + (1 - beta2) * g^2, then
+        // p -= decay * p + stepSize * m / (sqrt(v * secondMomentScale) + epsilon)
+        void (*adamStep)(T* p, T* m, T* v, const T* g, const AdamStep<T>& step, size_t n);
+    };
+
+    // Best instruction set supported by both the build and the running CPU.
+    // The EDGEMLP_ISA environment variable (scalar, avx2, avx512) can lower it.
+    Isa detectIsa();
+
+    // Kernels selected once, on first use, from detectIsa().
+    template<typename T>
+    const ElementwiseKernels<T>& elementwise();
+
+    // Kernels for a specific instruction set, or nullptr when it is unavailable.
+    template<typename T>
+    const ElementwiseKernels<T>* elementwiseFor(Isa isa);
+
+    const char* isaName(Isa isa);
+
+#ifdef EDGEMLP_X86_SIMD
+    template<typename T>
+    const ElementwiseKernels<T>& elementwiseAvx2();
+    template<typename T>
+    const ElementwiseKernels<T>& elementwiseAvx512();
+#endif
+}
+
+#endif //EDGEMLP_ELEMENTWISE_H
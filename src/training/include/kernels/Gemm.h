@@ -0,0 +1,46 @@
+#ifndef EDGEMLP_GEMM_H
+#define EDGEMLP_GEMM_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace kernels
+{
+    // C = alpha * op(A) * op(B) + beta * C on row-major buffers, where op(X) is X or X^T.
+    // op(A) is m x k, op(B) is k x n and C is m x n; lda/ldb/ldc are the row strides of
+    // the stored (untransposed) buffers. When beta == 0, C is not read. C must not alias A or B.
+    // Products are accumulated in Acc, so int8 operands can write an int32 C.
+    // Instantiated for <double, double>, <float, float>, <int8_t, int32_t> and <int32_t, int32_t>.
+    template<typename T, typename Acc = T>
+    void gemm(bool transA, bool transB, int m, int n, int k,
+              Acc alpha, const T* A, int lda,
+              const T* B, int ldb,
+              Acc beta, Acc* C, int ldc);
+
+    // Finishing work on C that gemm applies to each block as soon as its last k block
+    // has been accumulated, while the block is still in cache, instead of in separate
+    // passes over C. In order, every field being optional:
+    //   row i of C += bias[i * biasStride]
+    //   preActivation = C, with row stride ldPreActivation
+    //   apply(context, span, count) on spans of rows of C, in place
+    // apply may run concurrently on disjoint spans from any pool thread.
+    template<typename Acc>
+    struct GemmEpilogue
+    {
+        const Acc* bias = nullptr;
+        long biasStride = 1;
+        Acc* preActivation = nullptr;
+        int ldPreActivation = 0;
+        void (*apply)(void* context, Acc* values, size_t count) = nullptr;
+        void* context = nullptr;
+    };
+
+    // gemm followed by the epilogue on every element of C. preActivation must not alias C.
+    template<typename T, typename Acc = T>
+    void gemm(bool transA, bool transB, int m, int n, int k,
+              Acc alpha, const T* A, int lda,
+              const T* B, int ldb,
+              Acc beta, Acc* C, int ldc, const GemmEpilogue<Acc>& epilogue);
+}
+
+#endif //EDGEMLP_GEMM_H
@@ -0,0 +1,29 @@
+#ifndef EDGEMLP_OPTIMIZERMATH_H
+#define EDGEMLP_OPTIMIZERMATH_H
+
+#include <cmath>
+
+#include "Elementwise.h"
+
+namespace kernels
+{
+    // Scalar forms of the fused optimizer kernels, one parameter at a time, with the
+    // same order of operations as the SIMD paths.
+    template<typename T>
+    void momentumStep(T& p, T& velocity, const T g, const T lr, const T beta, const bool nesterov)
+    {
+        velocity = beta * velocity + g;
+        p -= lr * (nesterov ? g + beta * velocity : velocity);
+    }
+
+    template<typename T>
+    void adamStep(T& p, T& m, T& v, const T g, const AdamStep<T>& step)
+    {
+        m = step.beta1 * m + (1 - step.beta1) * g;
+        v = step.beta2 * v + (1 - step.beta2) * (g * g);
+        p -= step.decay * p;
+        p -= step.stepSize * (m / (std::sqrt(v * step.secondMomentScale) + step.epsilon));
+    }
+}
+
+#endif //EDGEMLP_OPTIMIZERMATH_H
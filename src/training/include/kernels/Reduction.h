@@ -0,0 +1,35 @@
+#ifndef EDGEMLP_REDUCTION_H
+#define EDGEMLP_REDUCTION_H
+
+#include <cstddef>
+
+#include "Elementwise.h"
+
+namespace kernels
+{
+    enum class ReductionMode
+    {
+        // Splits the range into one piece per pool task; the rounding depends on the thread count.
+        Fast,
+        // Evaluates the subtrees of the serial pairwise sum in parallel, so the result
+        // is bit-identical to a single-threaded run with any thread count.
+        Reproducible
+    };
+
+    // Mode used when a call does not name one; Fast unless changed.
+    ReductionMode reductionMode();
+    void setReductionMode(ReductionMode mode);
+
+    // Sum of a rows x cols matrix whose rows start ld elements apart (ld == cols when
+    // packed). Blocks of a few hundred elements go through the SIMD multi-accumulator
+    // kernel and are combined pairwise, so the rounding error grows with log(n)
+    // rather than n. Large inputs are split across the thread pool.
+    template<typename T>
+    accumulator_t<T> reduceSum(const T* a, size_t rows, size_t cols, size_t ld, ReductionMode mode = reductionMode());
+
+    // Single-threaded pairwise sum of a flat buffer.
+    template<typename T>
+    accumulator_t<T> pairwiseSum(const T* a, size_t n);
+}
+
+#endif //EDGEMLP_REDUCTION_H
@@ -0,0 +1,39 @@
+#ifndef EDGEMLP_SPARSE_KERNELS_H
+#define EDGEMLP_SPARSE_KERNELS_H
+
+#include <cstdint>
+
+namespace kernels
+{
+    // Compressed sparse rows: the nonzeros of row r are values[pointers[r] .. pointers[r + 1])
+    // in columns indices[...], sorted ascending. Compressed columns are the same arrays
+    // describing the transpose.
+    template<typename T>
+    struct Csr
+    {
+        const int* pointers;
+        const int* indices;
+        const T* values;
+    };
+
+    // C = alpha * op(S) * op(B) + beta * C where S is stored as CSR and op(B) is dense
+    // row-major (B^T when transB). op(S) is m x k, op(B) is k x n and C is m x n; with
+    // transS, S is stored as a k x m CSR matrix. Work is proportional to nnz(S) * n,
+    // and n == 1 is a sparse matrix-vector product. When beta == 0, C is not read.
+    // Instantiated like kernels::gemm.
+    template<typename T, typename Acc = T>
+    void spmm(bool transS, bool transB, int m, int n, int k,
+              Acc alpha, Csr<T> S, const T* B, int ldb,
+              Acc beta, Acc* C, int ldc);
+
+    // C = alpha * op(A) * op(S) + beta * C for a dense row-major op(A) (m x k) and a
+    // sparse op(S) (k x n). With transS, S is stored as an n x k CSR matrix, i.e. the
+    // columns of op(S) are compressed, and the work is m * nnz(S); otherwise it is
+    // m * (k + nnz(S)).
+    template<typename T, typename Acc = T>
+    void gemmSparse(bool transA, bool transS, int m, int n, int k,
+                    Acc alpha, const T* A, int lda, Csr<T> S,
+                    Acc beta, Acc* C, int ldc);
+}
+
+#endif //EDGEMLP_SPARSE_KERNELS_H
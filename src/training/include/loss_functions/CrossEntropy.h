@@ -0,0 +1,39 @@
+#ifndef EDGEMLP_CROSSENTROPY_H
+#define EDGEMLP_CROSSENTROPY_H
+
+#include "../Activation.h"
+#include "../Loss.h"
+
+// Categorical cross-entropy -sum(target * log(output)), averaged over the samples
+// (columns). Outputs are probabilities, normally from BasicSoftmax; they are
+// clamped away from zero before the log. Each target column is expected to sum to
+// one, e.g. a one-hot label, which is what lets the softmax gradient collapse to
+// output - target.
+template<typename T>
+class BasicCrossEntropy: public BasicLoss<T>
+{
+public:
+    // precision selects the exp behind softmaxCrossEntropy().
+    explicit BasicCrossEntropy(ActivationPrecision precision = ActivationPrecision::Exact);
+    T calculate(BasicMatrixView<T> output, BasicMatrixView<T> target) const override;
+    BasicMatrix<T> derivative(BasicMatrixView<T> output, BasicMatrixView<T> target) const override;
+    void derivative(BasicMatrixView<T> output, BasicMatrixView<T> target, BasicMatrix<T>& result) const override;
+    // Gradient with respect to the logits when output = softmax(logits):
+    // (output - target) / samples, without going through the softmax Jacobian.
+    void derivativeAfterSoftmax(BasicMatrixView<T> output, BasicMatrixView<T> target, BasicMatrix<T>& result) const;
+    // Fused softmax and cross-entropy on raw logits. Returns the mean loss, using
+    // log-sum-exp with the column maximum subtracted so large logits neither overflow
+    // nor take the log of zero. gradient, when given, must have the logits' shape and
+    // receives (softmax(logits) - target) / samples from the same pass.
+    T softmaxCrossEntropy(BasicMatrixView<T> logits, BasicMatrixView<T> target, BasicMatrix<T>* gradient = nullptr) const;
+private:
+    ActivationPrecision precision;
+
+    // softmaxCrossEntropy for inputs that are not row-major, one column at a time.
+    T softmaxCrossEntropyByColumn(BasicMatrixView<T> logits, BasicMatrixView<T> target, BasicMatrix<T>& gradient) const;
+};
+
+using CrossEntropy = BasicCrossEntropy<double>;
+using CrossEntropyF = BasicCrossEntropy<float>;
+
+#endif //EDGEMLP_CROSSENTROPY_H
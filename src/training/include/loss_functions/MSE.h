@@ -3,11 +3,16 @@
 
 #include "../Loss.h"
 
-class MSE: public Loss
+template<typename T>
+class BasicMSE: public BasicLoss<T>
 {
 public:
-    double calculate(const Matrix& output, const Matrix& target) const override;
-    Matrix derivative(const Matrix& output, const Matrix& target) const override;
+    T calculate(BasicMatrixView<T> output, BasicMatrixView<T> target) const override;
+    BasicMatrix<T> derivative(BasicMatrixView<T> output, BasicMatrixView<T> target) const override;
+    void derivative(BasicMatrixView<T> output, BasicMatrixView<T> target, BasicMatrix<T>& result) const override;
 };
 
-#endif //EDGEMLP_MSE_H
\ No newline at end of file
+using MSE = BasicMSE<double>;
+using MSEF = BasicMSE<float>;
+
+#endif //EDGEMLP_MSE_H
@@ -0,0 +1,37 @@
+#ifndef EDGEMLP_ADAM_H
+#define EDGEMLP_ADAM_H
+
+#include "../Optimizer.h"
+
+// Adam (Kingma & Ba): per-parameter steps from bias-corrected running means of the
+// gradient and of its square. The step counter advances in beginStep(), once per
+// training step, so every slot of a step sees the same bias correction.
+template<typename T>
+class BasicAdam: public BasicOptimizer<T>
+{
+public:
+    explicit BasicAdam(T beta1 = T(0.9), T beta2 = T(0.999), T epsilon = T(1e-8));
+    void beginStep() override;
+    void reset() override;
+    std::string name() const override;
+    long steps() const;
+protected:
+    // Decoupled weight decay per unit of learning rate; 0 for Adam.
+    BasicAdam(T beta1, T beta2, T epsilon, T weightDecay);
+    size_t stateCount() const override;
+    void updateSpan(T* parameters, T* const* state, const T* gradient, size_t count, T learningRate) const override;
+private:
+    T beta1;
+    T beta2;
+    T epsilon;
+    T weightDecay;
+    long step;
+    // 1 - beta^step of the current step.
+    T firstCorrection;
+    T secondCorrection;
+};
+
+using Adam = BasicAdam<double>;
+using AdamF = BasicAdam<float>;
+
+#endif //EDGEMLP_ADAM_H
@@ -0,0 +1,21 @@
+#ifndef EDGEMLP_ADAMW_H
+#define EDGEMLP_ADAMW_H
+
+#include "Adam.h"
+
+// Adam with decoupled weight decay (Loshchilov & Hutter): every step also shrinks
+// the parameters by learning rate * weightDecay * parameters, outside the moment
+// estimates, so the decay is not rescaled by the adaptive step. The decay applies
+// to every slot, biases included.
+template<typename T>
+class BasicAdamW: public BasicAdam<T>
+{
+public:
+    explicit BasicAdamW(T weightDecay = T(0.01), T beta1 = T(0.9), T beta2 = T(0.999), T epsilon = T(1e-8));
+    std::string name() const override;
+};
+
+using AdamW = BasicAdamW<double>;
+using AdamWF = BasicAdamW<float>;
+
+#endif //EDGEMLP_ADAMW_H
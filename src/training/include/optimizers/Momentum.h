@@ -0,0 +1,26 @@
+#ifndef EDGEMLP_MOMENTUM_H
+#define EDGEMLP_MOMENTUM_H
+
+#include "../Optimizer.h"
+
+// SGD with heavy-ball momentum: velocity = momentum * velocity + gradient, then
+// parameters -= learning rate * velocity.
+template<typename T>
+class BasicMomentum: public BasicOptimizer<T>
+{
+public:
+    explicit BasicMomentum(T momentum = T(0.9));
+    std::string name() const override;
+protected:
+    BasicMomentum(T momentum, bool nesterov);
+    size_t stateCount() const override;
+    void updateSpan(T* parameters, T* const* state, const T* gradient, size_t count, T learningRate) const override;
+private:
+    T momentum;
+    bool nesterov;
+};
+
+using Momentum = BasicMomentum<double>;
+using MomentumF = BasicMomentum<float>;
+
+#endif //EDGEMLP_MOMENTUM_H
@@ -0,0 +1,20 @@
+#ifndef EDGEMLP_NESTEROV_H
+#define EDGEMLP_NESTEROV_H
+
+#include "Momentum.h"
+
+// Nesterov momentum in the form that needs no extra forward pass: the velocity is
+// updated as for BasicMomentum, and the step looks ahead along it,
+// parameters -= learning rate * (gradient + momentum * velocity).
+template<typename T>
+class BasicNesterov: public BasicMomentum<T>
+{
+public:
+    explicit BasicNesterov(T momentum = T(0.9));
+    std::string name() const override;
+};
+
+using Nesterov = BasicNesterov<double>;
+using NesterovF = BasicNesterov<float>;
+
+#endif //EDGEMLP_NESTEROV_H
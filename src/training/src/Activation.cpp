@@ -1,14 +1,252 @@
 #include "../include/Activation.h"
 
-Matrix Activation::forward(const Matrix& m)
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    // Calls f(first, count) over spans of equal length that cover every element of
+    // the given equally shaped matrices: one flat range when they are all tight,
+    // otherwise one span per row. Spans run in parallel on the global pool.
+    template<typename T, typename F>
+    void forEachSpan(std::initializer_list<const BasicMatrix<T>*> matrices, const F& f)
+    {
+        const BasicMatrix<T>& shape = **matrices.begin();
+        const size_t rows = shape.getRows();
+        const size_t cols = shape.getCols();
+        const bool tight = std::all_of(matrices.begin(), matrices.end(),
+                                       [](const BasicMatrix<T>* m) { return m->isContiguous(); });
+        if (tight)
+        {
+            ThreadPool::global().parallelFor(0, rows * cols, ParallelGrain::ELEMENTWISE,
+                                             [&](const size_t first, const size_t last)
+            {
+                f(first, size_t(0), last - first);
+            });
+            return;
+        }
+        ThreadPool::global().parallelFor(0, rows, ParallelGrain::ELEMENTWISE / std::max<size_t>(cols, 1) + 1,
+                                         [&](const size_t first, const size_t last)
+        {
+            for (size_t r = first; r < last; r++)
+            {
+                f(size_t(0), r, cols);
+            }
+        });
+    }
+
+    template<typename T>
+    void requireSameShape(const BasicMatrix<T>& a, const BasicMatrix<T>& b, const char* what)
+    {
+        if (a.getRows() != b.getRows() || a.getCols() != b.getCols())
+        {
+            throw std::invalid_argument(std::string("Activation ") + what + " must have the same shape, got " +
+                                        std::to_string(a.getRows()) + "x" + std::to_string(a.getCols()) + " and " +
+                                        std::to_string(b.getRows()) + "x" + std::to_string(b.getCols()));
+        }
+    }
+
+    // Element-wise copy between equally shaped matrices of any leading dimension.
+    template<typename T>
+    void copyElements(const BasicMatrix<T>& from, BasicMatrix<T>& to)
+    {
+        forEachSpan<T>({&from, &to}, [&](const size_t offset, const size_t r, const size_t count)
+        {
+            const T* in = from.getData() + r * from.getLeadingDimension() + offset;
+            std::copy(in, in + count, to.getData() + r * to.getLeadingDimension() + offset);
+        });
+    }
+
+    // Address of element offset of row r, through m's leading dimension.
+    template<typename T, typename M>
+    T* at(M& m, const size_t r, const size_t offset)
+    {
+        return m.getData() + r * m.getLeadingDimension() + offset;
+    }
+}
+
+template<typename T>
+void BasicActivation<T>::forwardInPlace(T* values, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        values[i] = activate(values[i]);
+    }
+}
+
+template<typename T>
+void BasicActivation<T>::backwardInPlace(T* gradient, const T* input, const size_t count)
 {
-    Matrix res = m.map([this](const double x) { return this->activate(x); });
+    for (size_t i = 0; i < count; i++)
+    {
+        gradient[i] *= derivative(input[i]);
+    }
+}
+
+template<typename T>
+bool BasicActivation<T>::derivativeUsesOutput() const
+{
+    return false;
+}
+
+template<typename T>
+void BasicActivation<T>::backwardFromOutputInPlace(T*, const T*, size_t)
+{
+    throw std::logic_error(name() + " has no derivative in terms of its output");
+}
+
+template<typename T>
+bool BasicActivation<T>::isElementwise() const
+{
+    return true;
+}
+
+template<typename T>
+void BasicActivation<T>::forwardColumns(BasicMatrix<T>&)
+{
+    throw std::logic_error(name() + " is element-wise and has no column form");
+}
+
+template<typename T>
+void BasicActivation<T>::backwardColumnsFromOutput(BasicMatrix<T>&, const BasicMatrix<T>&)
+{
+    throw std::logic_error(name() + " is element-wise and has no column form");
+}
+
+template<typename T>
+BasicMatrix<T> BasicActivation<T>::forward(const BasicMatrix<T>& m)
+{
+    BasicMatrix<T> res(m);
+    forward(res, res);
     return res;
 }
 
-Matrix Activation::backward(const Matrix& upstreamGradient, const Matrix& activationInput)
+template<typename T>
+BasicMatrix<T> BasicActivation<T>::backward(const BasicMatrix<T>& upstreamGradient, const BasicMatrix<T>& activationInput)
 {
-    Matrix localGradient = activationInput.map([this](const  double x){return this->derivative(x);});
-    Matrix res = localGradient.hadamardProduct(upstreamGradient);
+    BasicMatrix<T> res(upstreamGradient);
+    backward(res, activationInput, res);
     return res;
 }
+
+template<typename T>
+void BasicActivation<T>::forward(const BasicMatrix<T>& m, BasicMatrix<T>& out)
+{
+    requireSameShape(m, out, "input and output");
+    if (!isElementwise())
+    {
+        if (&out != &m)
+        {
+            copyElements(m, out);
+        }
+        forwardColumns(out);
+        return;
+    }
+    forEachSpan<T>({&m, &out}, [&](const size_t offset, const size_t r, const size_t count)
+    {
+        T* values = at<T>(out, r, offset);
+        if (&out != &m)
+        {
+            const T* in = at<const T>(m, r, offset);
+            std::copy(in, in + count, values);
+        }
+        forwardInPlace(values, count);
+    });
+}
+
+template<typename T>
+void BasicActivation<T>::backward(const BasicMatrix<T>& upstreamGradient, const BasicMatrix<T>& activationInput, BasicMatrix<T>& out)
+{
+    backward(upstreamGradient, activationInput, out, false);
+}
+
+template<typename T>
+void BasicActivation<T>::backwardFromOutput(const BasicMatrix<T>& upstreamGradient, const BasicMatrix<T>& activationOutput, BasicMatrix<T>& out)
+{
+    if (!derivativeUsesOutput())
+    {
+        throw std::logic_error(name() + " has no derivative in terms of its output");
+    }
+    backward(upstreamGradient, activationOutput, out, true);
+}
+
+template<typename T>
+void BasicActivation<T>::backward(const BasicMatrix<T>& upstreamGradient, const BasicMatrix<T>& cached, BasicMatrix<T>& out, const bool fromOutput)
+{
+    requireSameShape(upstreamGradient, cached, "gradient and cached values");
+    requireSameShape(upstreamGradient, out, "gradient and output");
+    if (&out == &cached && &out != &upstreamGradient)
+    {
+        // The gradient is gathered into out first, so keep the values it would overwrite
+        const BasicMatrix<T> copy(cached);
+        backward(upstreamGradient, copy, out, fromOutput);
+        return;
+    }
+    if (!isElementwise())
+    {
+        const BasicMatrix<T> output = fromOutput ? BasicMatrix<T>(0, 0) : forward(cached);
+        if (&out != &upstreamGradient)
+        {
+            copyElements(upstreamGradient, out);
+        }
+        backwardColumnsFromOutput(out, fromOutput ? cached : output);
+        return;
+    }
+    forEachSpan<T>({&upstreamGradient, &cached, &out}, [&](const size_t offset, const size_t r, const size_t count)
+    {
+        T* gradient = at<T>(out, r, offset);
+        if (&out != &upstreamGradient)
+        {
+            const T* grad = at<const T>(upstreamGradient, r, offset);
+            std::copy(grad, grad + count, gradient);
+        }
+        if (fromOutput)
+        {
+            backwardFromOutputInPlace(gradient, at<const T>(cached, r, offset), count);
+        }
+        else
+        {
+            backwardInPlace(gradient, at<const T>(cached, r, offset), count);
+        }
+    });
+}
+
+template<typename T>
+void BasicActivation<T>::denseForward(const BasicMatrixView<T> weights, const BasicMatrixView<T> input,
+                                      const BasicMatrix<T>& bias, BasicMatrix<T>& out, BasicMatrix<T>* preActivation)
+{
+    if (bias.getRows() != out.getRows() || bias.getCols() != 1)
+    {
+        throw std::invalid_argument("Bias must be a column vector with one entry per output row");
+    }
+
+    kernels::GemmEpilogue<T> epilogue;
+    epilogue.bias = bias.getData();
+    epilogue.biasStride = bias.getLeadingDimension();
+    if (preActivation != nullptr)
+    {
+        if (preActivation->getRows() != out.getRows() || preActivation->getCols() != out.getCols())
+        {
+            throw std::invalid_argument("Pre-activation output must have the shape of the layer output");
+        }
+        epilogue.preActivation = preActivation->getData();
+        epilogue.ldPreActivation = preActivation->getLeadingDimension();
+    }
+    if (!isElementwise())
+    {
+        // The activation needs whole columns, so it runs after the product instead of per tile
+        gemm(out, weights, input, epilogue);
+        forwardColumns(out);
+        return;
+    }
+    epilogue.apply = [](void* context, T* values, const size_t count)
+    {
+        static_cast<BasicActivation*>(context)->forwardInPlace(values, count);
+    };
+    epilogue.context = this;
+    gemm(out, weights, input, epilogue);
+}
+
+template class BasicActivation<double>;
+template class BasicActivation<float>;
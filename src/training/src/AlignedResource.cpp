@@ -0,0 +1,25 @@
+#include "AlignedResource.h"
+
+#include <algorithm>
+#include <new>
+
+void* AlignedResource::do_allocate(const size_t bytes, const size_t alignment)
+{
+    return ::operator new(bytes, std::align_val_t(std::max(alignment, ALIGNMENT)));
+}
+
+void AlignedResource::do_deallocate(void* p, const size_t bytes, const size_t alignment)
+{
+    ::operator delete(p, bytes, std::align_val_t(std::max(alignment, ALIGNMENT)));
+}
+
+bool AlignedResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return dynamic_cast<const AlignedResource*>(&other) != nullptr;
+}
+
+std::pmr::memory_resource* alignedResource()
+{
+    static AlignedResource* resource = new AlignedResource();
+    return resource;
+}
@@ -0,0 +1,106 @@
+#include "Arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace
+{
+    size_t alignUp(const size_t value, const size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    std::byte* allocateAligned(const size_t bytes, const size_t alignment = Arena::ALIGNMENT)
+    {
+        return static_cast<std::byte*>(::operator new(bytes, std::align_val_t(alignment)));
+    }
+
+    void freeAligned(void* p, const size_t alignment = Arena::ALIGNMENT)
+    {
+        ::operator delete(p, std::align_val_t(alignment));
+    }
+}
+
+Arena::Arena(const size_t initialCapacity)
+    : buffer(nullptr), bufferCapacity(alignUp(initialCapacity, ALIGNMENT)), offset(0), overflowBytes(0)
+{
+    if (bufferCapacity > 0)
+    {
+        buffer = allocateAligned(bufferCapacity);
+    }
+}
+
+Arena::~Arena()
+{
+    for (const auto& block : overflow)
+    {
+        freeAligned(block.first, block.second);
+    }
+    if (buffer != nullptr)
+    {
+        freeAligned(buffer);
+    }
+}
+
+void Arena::reset()
+{
+    if (!overflow.empty())
+    {
+        // Grow to the peak this step needed so the next one fits in a single buffer
+        const size_t required = alignUp(offset + overflowBytes, ALIGNMENT);
+        for (const auto& block : overflow)
+        {
+            freeAligned(block.first, block.second);
+        }
+        overflow.clear();
+        overflowBytes = 0;
+        if (buffer != nullptr)
+        {
+            freeAligned(buffer);
+        }
+        buffer = allocateAligned(required);
+        bufferCapacity = required;
+    }
+    offset = 0;
+}
+
+size_t Arena::capacity() const
+{
+    return bufferCapacity;
+}
+
+size_t Arena::used() const
+{
+    return offset + overflowBytes;
+}
+
+void* Arena::do_allocate(const size_t bytes, const size_t alignment)
+{
+    const size_t align = std::max(alignment, ALIGNMENT);
+    // Align the address rather than the offset: the buffer itself is only cache-line aligned
+    const auto base = reinterpret_cast<std::uintptr_t>(buffer);
+    const size_t start = alignUp(base + offset, align) - base;
+    if (buffer != nullptr && start + bytes <= bufferCapacity)
+    {
+        offset = start + bytes;
+        return buffer + start;
+    }
+
+    // Count the alignment padding too, so the grown buffer fits the same sequence
+    const size_t size = alignUp(std::max<size_t>(bytes, 1), ALIGNMENT);
+    void* block = allocateAligned(size, align);
+    overflow.emplace_back(block, align);
+    overflowBytes += size + align - ALIGNMENT;
+    return block;
+}
+
+void Arena::do_deallocate(void*, size_t, size_t)
+{
+    // Memory is reclaimed all at once by reset()
+}
+
+bool Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
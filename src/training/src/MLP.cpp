@@ -1,6 +1,41 @@
 #include "../include/MLP.h"
+#include "../include/activation_functions/Softmax.h"
+#include "../include/loss_functions/CrossEntropy.h"
 
-MLP::MLP(const std::vector<int>& sizes, const std::vector<std::shared_ptr<Activation>>& activations, const double learning_rate, const std::shared_ptr<Loss>& loss) : learning_rate(learning_rate), loss_function(loss), layer_size(sizes), activations(activations)
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    // CSR stores an index next to every value and gathers its operand, so a layer
+    // only pays off in sparse form once most of its weights are zero.
+    constexpr double MAX_SPARSE_DENSITY = 0.3;
+
+    // Batch widths whose layer buffers are kept besides the current one; inference on
+    // many different widths drops them all rather than holding memory for each.
+    constexpr size_t MAX_PARKED_BATCH_WIDTHS = 4;
+
+    // *weight -= step with relaxed atomic accesses, for parameters shared by Hogwild
+    // workers: a concurrent update of the same weight may be lost, but a reader never
+    // sees a half-written value.
+    template<typename T>
+    void racySubtract(T* weight, const T step)
+    {
+#if defined(__GNUC__)
+        T current;
+        __atomic_load(weight, &current, __ATOMIC_RELAXED);
+        const T updated = current - step;
+        __atomic_store(weight, &updated, __ATOMIC_RELAXED);
+#else
+        *weight -= step;
+#endif
+    }
+}
+
+template<typename T>
+BasicMLP<T>::BasicMLP(const std::vector<int>& sizes, const std::vector<std::shared_ptr<Activation>>& activations, const T learning_rate, const std::shared_ptr<Loss>& loss) : learning_rate(learning_rate), loss_function(loss), layer_size(sizes), activations(activations)
 {
     if (sizes.size() < 2)
     {
@@ -12,6 +47,7 @@ MLP::MLP(const std::vector<int>& sizes, const std::vector<std::shared_ptr<Activa
         throw std::invalid_argument("The number of activation functions must be equal to the number of layers minus one");
     }
 
+    sparse_weights.resize(sizes.size() - 1);
     for (size_t i{}; i < sizes.size() - 1; i++)
     {
         const int n_in = sizes[i];
@@ -19,14 +55,66 @@ MLP::MLP(const std::vector<int>& sizes, const std::vector<std::shared_ptr<Activa
 
         Matrix w(n_out, n_in);
         w.heInit(); // He initialization
-        weights.push_back(w);
+        weights.push_back(std::move(w));
 
         Matrix b(n_out, 1);
-        biases.push_back(b);
+        biases.push_back(std::move(b));
+    }
+    workspace = makeWorkspace();
+}
+
+template<typename T>
+BasicMLP<T>::BasicMLP(const BasicMLP& other)
+    : learning_rate(other.learning_rate), loss_function(other.loss_function), optimizer(other.optimizer),
+      weights(other.weights), biases(other.biases), layer_size(other.layer_size), activations(other.activations),
+      sparse_weights(other.sparse_weights)
+{
+    if (other.workspace)
+    {
+        workspace = makeWorkspace();
+    }
+}
+
+template<typename T>
+BasicMLP<T>& BasicMLP<T>::operator=(const BasicMLP& other)
+{
+    if (this != &other)
+    {
+        BasicMLP copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template<typename T>
+typename BasicMLP<T>::Workspace& BasicMLP<T>::ownWorkspace()
+{
+    if (!workspace)
+    {
+        throw std::logic_error("MLP has no layers: it was default-constructed or moved from");
     }
+    return *workspace;
 }
 
-std::ostream& operator<<(std::ostream& os, const MLP& m)
+template<typename T>
+std::unique_ptr<typename BasicMLP<T>::Workspace> BasicMLP<T>::makeWorkspace() const
+{
+    auto ws = std::make_unique<Workspace>();
+    ws->deltas.reserve(weights.size());
+    ws->active_inputs.reserve(layer_size[0]);
+    ws->a_values.emplace_back(0, 0);
+    for (size_t i = 0; i < weights.size(); i++)
+    {
+        ws->z_values.emplace_back(layer_size[i + 1], 1);
+        ws->a_values.emplace_back(layer_size[i + 1], 1);
+        ws->nabla_w.emplace_back(layer_size[i + 1], layer_size[i]);
+        ws->nabla_b.emplace_back(layer_size[i + 1], 1);
+    }
+    return ws;
+}
+
+template<typename T>
+std::ostream& operator<<(std::ostream& os, const BasicMLP<T>& m)
 {
     for (size_t i = 0; i < m.layer_size.size(); ++i) {
         os << "  Layer " << i << ": " << m.layer_size[i] << " neurons";
@@ -38,66 +126,358 @@ std::ostream& operator<<(std::ostream& os, const MLP& m)
     return os;
 }
 
-Matrix MLP::forward(const Matrix& input)
+template<typename T>
+BasicMatrix<T> BasicMLP<T>::forward(const MatrixView input)
+{
+    Workspace& ws = ownWorkspace();
+    feedForward(ws, input);
+    return ws.a_values.back();
+}
+
+template<typename T>
+void BasicMLP<T>::resizeBatch(Workspace& ws, const int batch) const
 {
-    if (input.getRows() != layer_size[0] || input.getCols() != 1) {
+    const int current = ws.a_values.back().getCols();
+    if (current == batch) {
+        return;
+    }
+
+    if (ws.parked_buffers.size() >= MAX_PARKED_BATCH_WIDTHS && ws.parked_buffers.count(batch) == 0) {
+        ws.parked_buffers.clear();
+    }
+    LayerBuffers& park = ws.parked_buffers[current];
+    park.z_values.swap(ws.z_values);
+    park.a_values.swap(ws.a_values);
+
+    // Buffers of this width are allocated the first time it is seen and reused afterwards
+    LayerBuffers& reuse = ws.parked_buffers[batch];
+    if (reuse.a_values.empty()) {
+        reuse.a_values.emplace_back(0, 0);
+        for (size_t i = 0; i < weights.size(); i++) {
+            reuse.z_values.emplace_back(layer_size[i + 1], batch);
+            reuse.a_values.emplace_back(layer_size[i + 1], batch);
+        }
+    }
+    ws.z_values.swap(reuse.z_values);
+    ws.a_values.swap(reuse.a_values);
+}
+
+template<typename T>
+void BasicMLP<T>::feedForward(Workspace& ws, const MatrixView input) const
+{
+    if (input.getRows() != layer_size[0] || input.getCols() < 1) {
         throw std::invalid_argument("Input matrix dimensions do not match the input layer size.");
     }
 
-    z_values.clear();
-    a_values.clear();
+    resizeBatch(ws, input.getCols());
+    ws.input = input;
+    propagateFrom(ws, 0);
+}
 
-    Matrix current_a = input;
-    a_values.push_back(current_a);
+template<typename T>
+BasicMatrix<T> BasicMLP<T>::forward(const SparseMatrix& input)
+{
+    if (input.getRows() != layer_size[0] || input.getCols() < 1) {
+        throw std::invalid_argument("Input matrix dimensions do not match the input layer size.");
+    }
 
+    Workspace& ws = ownWorkspace();
+    resizeBatch(ws, input.getCols());
+    if (sparse_weights[0]) {
+        // Sparse times sparse is not supported: densify the input for a pruned first layer
+        ws.a_values[0] = input.toDense();
+        ws.input = ws.a_values[0].view();
+        propagateFrom(ws, 0);
+    } else {
+        gemm(ws.z_values[0], weights[0], input);
+        activateLayer(ws, 0);
+        propagateFrom(ws, 1);
+    }
+    return ws.a_values.back();
+}
 
-    for (size_t i {}; i < weights.size(); i++)
+template<typename T>
+void BasicMLP<T>::propagateFrom(Workspace& ws, const size_t layer) const
+{
+    for (size_t i = layer; i < weights.size(); i++)
     {
-        const Matrix& w = weights[i];
-        const Matrix& b = biases[i];
-        const auto& activation = activations[i];
+        // z = w * a + b, then a' = activation(z), all into preallocated buffers
+        if (sparse_weights[i]) {
+            gemm(ws.z_values[i], *sparse_weights[i], layerInput(ws, i));
+            activateLayer(ws, i);
+        } else {
+            // Fused into the GEMM epilogue; z is only stored when backprop needs it
+            Activation& activation = *activations[i];
+            activation.denseForward(weights[i], layerInput(ws, i), biases[i], ws.a_values[i + 1],
+                                    activation.derivativeUsesOutput() ? nullptr : &ws.z_values[i]);
+        }
+    }
+}
 
-        Matrix z = (w * current_a) + b;
-        z_values.push_back(z);
+template<typename T>
+BasicMatrixView<T> BasicMLP<T>::layerInput(const Workspace& ws, const size_t layer) const
+{
+    return layer == 0 ? ws.input : ws.a_values[layer].view();
+}
 
-        current_a = activation->forward(z);
-        a_values.push_back(current_a);
+template<typename T>
+void BasicMLP<T>::activateLayer(Workspace& ws, const size_t layer) const
+{
+    ws.z_values[layer].addToColumns(biases[layer]);
+    activations[layer]->forward(ws.z_values[layer], ws.a_values[layer + 1]);
+}
+
+// deltas[layer] *= activation'(z), read from the cached output a when the activation allows it.
+template<typename T>
+void BasicMLP<T>::backwardActivation(Workspace& ws, const size_t layer) const
+{
+    Activation& activation = *activations[layer];
+    if (activation.derivativeUsesOutput())
+    {
+        activation.backwardFromOutput(ws.deltas[layer], ws.a_values[layer + 1], ws.deltas[layer]);
     }
+    else
+    {
+        activation.backward(ws.deltas[layer], ws.z_values[layer], ws.deltas[layer]);
+    }
+}
 
-    return current_a;
+template<typename T>
+void BasicMLP<T>::pruneWeights(const T threshold)
+{
+    for (size_t l = 0; l < weights.size(); l++) {
+        weights[l].applyFunction([threshold](const T w) { return std::abs(w) <= threshold ? T(0) : w; });
+        SparseMatrix pruned(weights[l], Layout::RowMajor, threshold);
+        if (pruned.density() <= MAX_SPARSE_DENSITY) {
+            sparse_weights[l] = std::move(pruned);
+        } else {
+            sparse_weights[l].reset();
+        }
+    }
 }
 
-void MLP::backpropagate(const Matrix& input, const Matrix& output)
+template<typename T>
+void BasicMLP<T>::computeGradients(Workspace& ws, const MatrixView input, const MatrixView output, const T gradientScale,
+                                   const bool firstLayerWeights) const
 {
-    forward(input);
+    feedForward(ws, input);
 
-    std::vector<Matrix> nabla_b, nabla_w;
-    for (const auto& b : biases) nabla_b.emplace_back(b.getRows(), b.getCols());
-    for (const auto& w : weights) nabla_w.emplace_back(w.getRows(), w.getCols());
+    // Deltas are step scratch: borrowed from the workspace arena and released by the
+    // reset at the end of the step, so no step touches the heap once the arena has grown.
+    ws.deltas.clear();
+    for (size_t l = 0; l < weights.size(); l++)
+    {
+        ws.deltas.emplace_back(layer_size[l + 1], input.getCols(), &ws.arena);
+    }
 
-    // 1. Compute delta output
-    const Matrix cost_deriv = loss_function->derivative(a_values.back(), output);
-    Matrix delta = activations.back()->backward(cost_deriv, z_values.back());
-    nabla_b.back() = delta;
-    nabla_w.back() = delta * a_values[a_values.size() - 2].transpose();
+    // 1. Compute delta output; softmax into cross-entropy collapses to (a - y) / samples
+    const auto* crossEntropy = dynamic_cast<const BasicCrossEntropy<T>*>(loss_function.get());
+    if (crossEntropy != nullptr && dynamic_cast<const BasicSoftmax<T>*>(activations.back().get()) != nullptr)
+    {
+        crossEntropy->derivativeAfterSoftmax(ws.a_values.back(), output, ws.deltas.back());
+    }
+    else
+    {
+        loss_function->derivative(ws.a_values.back(), output, ws.deltas.back());
+        backwardActivation(ws, weights.size() - 1);
+    }
 
     // 2. Propagation in the hidden layers
     for (int l = static_cast<int>(weights.size()) - 2; l >= 0; --l) {
-        Matrix wT_delta = weights[l + 1].transpose() * delta;
-        delta = activations[l]->backward(wT_delta, z_values[l]);
-        nabla_b[l] = delta;
-        nabla_w[l] = delta * a_values[l].transpose();
+        gemm(ws.deltas[l], weights[l + 1], ws.deltas[l + 1], 1, 0, true, false);
+        backwardActivation(ws, l);
     }
 
-    // 3. Update parameters
+    // Each delta column already carries its sample's share of the batch-mean loss, so
+    // dC/db sums the deltas over the batch and dC/dw == delta * a^T sums them in the product
+    for (size_t l = 0; l < weights.size(); l++) {
+        ws.deltas[l].sumRows(ws.nabla_b[l]);
+        if (gradientScale != T(1)) {
+            ws.nabla_b[l] *= gradientScale;
+        }
+        if (l > 0 || firstLayerWeights) {
+            gemm(ws.nabla_w[l], ws.deltas[l].view(), layerInput(ws, l), gradientScale, 0, false, true);
+        }
+    }
+}
+
+template<typename T>
+void BasicMLP<T>::releaseStepScratch(Workspace& ws) const
+{
+    ws.deltas.clear();
+    ws.arena.reset();
+}
+
+// 3. Update parameters; pruned copies no longer match the dense weights
+template<typename T>
+void BasicMLP<T>::applyGradients(const Workspace& ws)
+{
+    if (optimizer) {
+        optimizer->beginStep();
+    }
     for (size_t i = 0; i < weights.size(); ++i) {
-        weights[i] = weights[i] - nabla_w[i] * learning_rate;
-        biases[i] = biases[i] - nabla_b[i] * learning_rate;
+        if (optimizer) {
+            optimizer->update(2 * i, weights[i], ws.nabla_w[i], learning_rate);
+            optimizer->update(2 * i + 1, biases[i], ws.nabla_b[i], learning_rate);
+        } else {
+            weights[i].axpy(-learning_rate, ws.nabla_w[i]);
+            biases[i].axpy(-learning_rate, ws.nabla_b[i]);
+        }
+        sparse_weights[i].reset();
+    }
+}
+
+template<typename T>
+void BasicMLP<T>::backpropagate(const MatrixView input, const MatrixView output)
+{
+    Workspace& ws = ownWorkspace();
+    computeGradients(ws, input, output, T(1));
+    releaseStepScratch(ws);
+    applyGradients(ws);
+}
+
+template<typename T>
+void BasicMLP<T>::backpropagateParallel(const MatrixView input, const MatrixView output, const int shards)
+{
+    ownWorkspace(); // a network without layers has nothing to shard
+    if (shards < 1) {
+        throw std::invalid_argument("A data-parallel step needs at least one shard.");
+    }
+    if (input.getRows() != layer_size[0] || input.getCols() < 1) {
+        throw std::invalid_argument("Input matrix dimensions do not match the input layer size.");
+    }
+    if (output.getRows() != layer_size.back() || output.getCols() != input.getCols()) {
+        throw std::invalid_argument("Target matrix dimensions do not match the output layer and the input batch.");
+    }
+
+    // Shards are never empty, and shard s covers columns [batch * s / count, batch * (s + 1) / count)
+    const int batch = input.getCols();
+    const int count = std::min(shards, batch);
+    while (shard_workspaces.size() < static_cast<size_t>(count)) {
+        shard_workspaces.push_back(makeWorkspace());
+    }
+    const auto shardBegin = [&](const int s) { return static_cast<int>(static_cast<long>(batch) * s / count); };
+
+    // Each shard's loss averages over its own columns; scaling by its share of the
+    // batch turns the sum of the shard gradients into the batch mean.
+    ThreadPool& pool = ThreadPool::global();
+    pool.parallelFor(0, count, 1, [&](const size_t first, const size_t last)
+    {
+        for (size_t s = first; s < last; s++) {
+            const int begin = shardBegin(static_cast<int>(s));
+            const int end = shardBegin(static_cast<int>(s) + 1);
+            computeGradients(*shard_workspaces[s], input.colRange(begin, end), output.colRange(begin, end),
+                             static_cast<T>(end - begin) / static_cast<T>(batch));
+            releaseStepScratch(*shard_workspaces[s]);
+        }
+    });
+
+    // Tree all-reduce: at each level, shard s absorbs shard s + stride for every s that
+    // is a multiple of 2 * stride, so the total lands in shard 0 after log2(count) levels.
+    for (int stride = 1; stride < count; stride *= 2) {
+        const int pairs = (count - stride + 2 * stride - 1) / (2 * stride);
+        pool.parallelFor(0, pairs, 1, [&](const size_t first, const size_t last)
+        {
+            for (size_t p = first; p < last; p++) {
+                Workspace& into = *shard_workspaces[p * 2 * stride];
+                const Workspace& from = *shard_workspaces[p * 2 * stride + stride];
+                for (size_t l = 0; l < weights.size(); l++) {
+                    into.nabla_w[l].axpy(1, from.nabla_w[l]);
+                    into.nabla_b[l].axpy(1, from.nabla_b[l]);
+                }
+            }
+        });
+    }
+    applyGradients(*shard_workspaces[0]);
+}
+
+template<typename T>
+void BasicMLP<T>::applyGradientsHogwild(Workspace& ws)
+{
+    // First layer: dC/dw(r, j) = sum over the batch of delta(r, b) * input(j, b), which
+    // is zero for every input j that is zero throughout the batch
+    const MatrixView input = ws.input;
+    const int batch = input.getCols();
+    // Input j of sample b is at j * featureStride + b * sampleStride in either layout
+    const bool rowMajor = input.getLayout() == Layout::RowMajor;
+    const size_t featureStride = rowMajor ? input.getLeadingDimension() : 1;
+    const size_t sampleStride = rowMajor ? 1 : input.getLeadingDimension();
+    ws.active_inputs.clear();
+    for (int j = 0; j < input.getRows(); j++) {
+        const T* values = input.getData() + j * featureStride;
+        for (int b = 0; b < batch; b++) {
+            if (values[b * sampleStride] != 0) {
+                ws.active_inputs.push_back(j);
+                break;
+            }
+        }
+    }
+    const Matrix& delta = ws.deltas[0];
+    Matrix& w = weights[0];
+    for (int r = 0; r < w.getRows(); r++) {
+        const T* deltaRow = delta.getData() + static_cast<size_t>(r) * delta.getLeadingDimension();
+        T* weightRow = w.getData() + static_cast<size_t>(r) * w.getLeadingDimension();
+        for (const int j : ws.active_inputs) {
+            const T* inputRow = input.getData() + j * featureStride;
+            T gradient = 0;
+            for (int b = 0; b < batch; b++) {
+                gradient += deltaRow[b] * inputRow[b * sampleStride];
+            }
+            racySubtract(weightRow + j, learning_rate * gradient);
+        }
+    }
+
+    for (size_t l = 0; l < weights.size(); l++) {
+        Matrix& wl = weights[l];
+        for (int r = 0; r < wl.getRows(); r++) {
+            if (l > 0) {
+                T* weightRow = wl.getData() + static_cast<size_t>(r) * wl.getLeadingDimension();
+                const T* gradientRow = ws.nabla_w[l].getData() + static_cast<size_t>(r) * ws.nabla_w[l].getLeadingDimension();
+                for (int j = 0; j < wl.getCols(); j++) {
+                    racySubtract(weightRow + j, learning_rate * gradientRow[j]);
+                }
+            }
+            racySubtract(&biases[l](r, 0), learning_rate * ws.nabla_b[l](r, 0));
+        }
     }
 }
 
-void MLP::train(const Matrix& X, const Matrix& y, const int epochs, const double lr)
+// Workers claim batches from a shared counter until the epoch is used up; a worker
+// whose chunk runs after the others finds the counter exhausted and does nothing.
+template<typename T>
+void BasicMLP<T>::trainHogwildEpoch(const MatrixView X, const MatrixView y, const int batch_size, const int workers)
 {
+    while (shard_workspaces.size() < static_cast<size_t>(workers)) {
+        shard_workspaces.push_back(makeWorkspace());
+    }
+    const int samples = X.getCols();
+    std::atomic<int> next{0};
+    ThreadPool::global().parallelFor(0, workers, 1, [&](const size_t first, const size_t last)
+    {
+        for (size_t w = first; w < last; w++) {
+            Workspace& ws = *shard_workspaces[w];
+            for (int i = next.fetch_add(batch_size, std::memory_order_relaxed); i < samples;
+                 i = next.fetch_add(batch_size, std::memory_order_relaxed)) {
+                const int end = std::min(i + batch_size, samples);
+                computeGradients(ws, X.colRange(i, end), y.colRange(i, end), T(1), false);
+                applyGradientsHogwild(ws);
+                releaseStepScratch(ws);
+            }
+        }
+    });
+}
+
+template<typename T>
+void BasicMLP<T>::train(const MatrixView X, const MatrixView y, const int epochs, const T lr, const int batch_size,
+                        const int workers, const TrainingMode mode)
+{
+    ownWorkspace(); // a network without layers cannot be trained
+    if (batch_size < 1) {
+        throw std::invalid_argument("Batch size must be at least 1.");
+    }
+    if (workers < 1) {
+        throw std::invalid_argument("Training needs at least one worker.");
+    }
     if (X.getCols() != y.getCols()) {
         throw std::invalid_argument("Il numero di esempi in X e y deve essere uguale.");
     }
@@ -107,10 +487,20 @@ void MLP::train(const Matrix& X, const Matrix& y, const int epochs, const double
     if (y.getRows() != layer_size.back()) {
         throw std::invalid_argument("Le dimensioni di y non corrispondono allo strato di output.");
     }
+    if (mode == TrainingMode::Hogwild && optimizer) {
+        // Optimizer state is updated in whole-matrix passes, which lock-free workers would race on
+        throw std::invalid_argument("Hogwild training supports plain SGD only.");
+    }
 
     if (lr > 0) {
         learning_rate = lr;
     }
+    if (mode == TrainingMode::Hogwild) {
+        // Workers must not reset the optionals concurrently, so drop the pruned copies up front
+        for (auto& sparse : sparse_weights) {
+            sparse.reset();
+        }
+    }
     bool printStatus = true;
     for (int epoch = 0; epoch < epochs; ++epoch) {
         if (epoch%100 == 0)
@@ -119,10 +509,17 @@ void MLP::train(const Matrix& X, const Matrix& y, const int epochs, const double
             printStatus = true;
 
         }
-        for (int i = 0; i < X.getCols(); ++i) {
-            Matrix x_i = X.col(i);
-            Matrix y_i = y.col(i);
-            backpropagate(x_i, y_i);
+        if (mode == TrainingMode::Hogwild) {
+            trainHogwildEpoch(X, y, batch_size, workers);
+        } else {
+            for (int i = 0; i < X.getCols(); i += batch_size) {
+                const int end = std::min(i + batch_size, X.getCols());
+                if (workers > 1) {
+                    backpropagateParallel(X.colRange(i, end), y.colRange(i, end), workers);
+                } else {
+                    backpropagate(X.colRange(i, end), y.colRange(i, end));
+                }
+            }
         }
         if (printStatus)
         {
@@ -131,3 +528,8 @@ void MLP::train(const Matrix& X, const Matrix& y, const int epochs, const double
         printStatus = false;
     }
 }
+
+template class BasicMLP<double>;
+template class BasicMLP<float>;
+template std::ostream& operator<<(std::ostream& os, const BasicMLP<double>& m);
+template std::ostream& operator<<(std::ostream& os, const BasicMLP<float>& m);
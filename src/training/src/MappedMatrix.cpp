@@ -0,0 +1,190 @@
+#include "MappedMatrix.h"
+
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // Mappings must start on this boundary, so offsets are rounded down to it.
+    size_t mappingGranularity()
+    {
+#if defined(_WIN32)
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        return info.dwAllocationGranularity;
+#else
+        return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+    [[noreturn]] void mappingFailed(const std::string& path, const char* step)
+    {
+        throw std::runtime_error("Cannot map " + path + ": " + step + " failed");
+    }
+
+    void requireFileSize(const std::string& path, const unsigned long long fileSize, const size_t required)
+    {
+        if (fileSize < required)
+        {
+            throw std::invalid_argument(
+                "File " + path + " holds " + std::to_string(fileSize) + " bytes but the matrix needs " +
+                std::to_string(required));
+        }
+    }
+
+    void* mapReadOnly(const std::string& path, const size_t start, const size_t length, const size_t required)
+    {
+#if defined(_WIN32)
+        const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            mappingFailed(path, "open");
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize))
+        {
+            CloseHandle(file);
+            mappingFailed(path, "stat");
+        }
+        try
+        {
+            requireFileSize(path, static_cast<unsigned long long>(fileSize.QuadPart), required);
+        }
+        catch (...)
+        {
+            CloseHandle(file);
+            throw;
+        }
+        const HANDLE section = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (section == nullptr)
+            mappingFailed(path, "CreateFileMapping");
+        // The view keeps the section alive after its handle is closed
+        void* base = MapViewOfFile(section, FILE_MAP_READ, static_cast<DWORD>(static_cast<unsigned long long>(start) >> 32),
+                                   static_cast<DWORD>(start & 0xFFFFFFFFu), length);
+        CloseHandle(section);
+        if (base == nullptr)
+            mappingFailed(path, "MapViewOfFile");
+        return base;
+#else
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            mappingFailed(path, "open");
+        struct stat info{};
+        if (fstat(fd, &info) != 0)
+        {
+            close(fd);
+            mappingFailed(path, "stat");
+        }
+        try
+        {
+            requireFileSize(path, static_cast<unsigned long long>(info.st_size), required);
+        }
+        catch (...)
+        {
+            close(fd);
+            throw;
+        }
+        // The mapping keeps the file referenced after the descriptor is closed
+        void* base = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, static_cast<off_t>(start));
+        close(fd);
+        if (base == MAP_FAILED)
+            mappingFailed(path, "mmap");
+        return base;
+#endif
+    }
+
+    void unmapReadOnly(void* base, const size_t length)
+    {
+#if defined(_WIN32)
+        (void)length;
+        UnmapViewOfFile(base);
+#else
+        munmap(base, length);
+#endif
+    }
+}
+
+template<typename T>
+BasicMappedMatrix<T>::BasicMappedMatrix(const std::string& path, const int rows, const int cols, const Layout layout,
+                                        const size_t offset)
+    : mapping(nullptr), mappingSize(0), data(nullptr), rows(rows), cols(cols), layout(layout)
+{
+    if (rows < 0 || cols < 0)
+    {
+        throw std::invalid_argument("Matrix dimensions must be non-negative");
+    }
+    if (offset % alignof(T) != 0)
+    {
+        throw std::invalid_argument("Offset " + std::to_string(offset) + " is not aligned for the element type");
+    }
+
+    const size_t bytes = static_cast<size_t>(rows) * cols * sizeof(T);
+    if (bytes == 0)
+    {
+        return;
+    }
+    const size_t start = offset / mappingGranularity() * mappingGranularity();
+    mappingSize = offset - start + bytes;
+    mapping = mapReadOnly(path, start, mappingSize, offset + bytes);
+    data = reinterpret_cast<const T*>(static_cast<const std::byte*>(mapping) + (offset - start));
+}
+
+template<typename T>
+BasicMappedMatrix<T>::~BasicMappedMatrix()
+{
+    unmap();
+}
+
+template<typename T>
+BasicMappedMatrix<T>::BasicMappedMatrix(BasicMappedMatrix&& other) noexcept
+    : mapping(std::exchange(other.mapping, nullptr)), mappingSize(std::exchange(other.mappingSize, 0)),
+      data(std::exchange(other.data, nullptr)), rows(std::exchange(other.rows, 0)), cols(std::exchange(other.cols, 0)),
+      layout(other.layout)
+{
+}
+
+template<typename T>
+BasicMappedMatrix<T>& BasicMappedMatrix<T>::operator=(BasicMappedMatrix&& other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+        mapping = std::exchange(other.mapping, nullptr);
+        mappingSize = std::exchange(other.mappingSize, 0);
+        data = std::exchange(other.data, nullptr);
+        rows = std::exchange(other.rows, 0);
+        cols = std::exchange(other.cols, 0);
+        layout = other.layout;
+    }
+    return *this;
+}
+
+template<typename T>
+BasicMatrixView<T> BasicMappedMatrix<T>::view() const
+{
+    return BasicMatrixView<T>(data, rows, cols, layout == Layout::RowMajor ? cols : rows, layout);
+}
+
+template<typename T>
+void BasicMappedMatrix<T>::unmap()
+{
+    if (mapping != nullptr)
+    {
+        unmapReadOnly(mapping, mappingSize);
+        mapping = nullptr;
+    }
+}
+
+template class BasicMappedMatrix<double>;
+template class BasicMappedMatrix<float>;
+template class BasicMappedMatrix<int8_t>;
+template class BasicMappedMatrix<int32_t>;
@@ -1,43 +1,91 @@
 #include "Matrix.h"
+#include "kernels/Elementwise.h"
+#include "kernels/Gemm.h"
+#include "kernels/Reduction.h"
 
 #include <stdexcept>
 #include <algorithm>
 #include <random>
 
-Matrix::Matrix(const int rows, const int cols) : rows(rows), cols(cols), data(rows * cols, 0.0)
+template<typename T>
+BasicMatrix<T>::BasicMatrix(const int rows, const int cols)
+    : rows(rows), cols(cols), ld(cols), data(rows * cols, T(0), alignedResource())
 {
 }
 
-int Matrix::getRows() const
+template<typename T>
+BasicMatrix<T>::BasicMatrix(const int rows, const int cols, std::pmr::memory_resource* resource)
+    : rows(rows), cols(cols), ld(cols), data(rows * cols, T(0), resource)
+{
+}
+
+template<typename T>
+BasicMatrix<T>::BasicMatrix(const BasicMatrix& m) : rows(m.rows), cols(m.cols), ld(m.ld), data(m.data, alignedResource())
+{
+}
+
+template<typename T>
+BasicMatrix<T> BasicMatrix<T>::withLeadingDimension(const int rows, const int cols, const int ld,
+                                                    std::pmr::memory_resource* resource)
+{
+    if (ld < cols)
+    {
+        throw std::invalid_argument(
+            "Leading dimension " + std::to_string(ld) + " is smaller than the column count " + std::to_string(cols));
+    }
+    BasicMatrix result(0, 0, resource);
+    result.rows = rows;
+    result.cols = cols;
+    result.ld = ld;
+    result.data.assign(static_cast<size_t>(rows) * ld, T(0));
+    return result;
+}
+
+template<typename T>
+BasicMatrix<T> BasicMatrix<T>::padded(const int rows, const int cols, std::pmr::memory_resource* resource)
+{
+    constexpr int lanes = AlignedResource::ALIGNMENT / sizeof(T);
+    return withLeadingDimension(rows, cols, (cols + lanes - 1) / lanes * lanes, resource);
+}
+
+template<typename T>
+int BasicMatrix<T>::getRows() const
 {
     return rows;
 }
 
-int Matrix::getCols() const
+template<typename T>
+int BasicMatrix<T>::getCols() const
 {
     return cols;
 }
 
-double& Matrix::operator()(const int row, const int col)
+template<typename T>
+T& BasicMatrix<T>::operator()(const int row, const int col)
 {
-    return data[row * cols + col];
+    return data[static_cast<size_t>(row) * ld + col];
 }
 
-double Matrix::operator()(const int row, const int col) const
+template<typename T>
+T BasicMatrix<T>::operator()(const int row, const int col) const
 {
-    return data[row * cols + col];
+    return data[static_cast<size_t>(row) * ld + col];
 }
 
-const double* Matrix::getData() const
+template<typename T>
+const T* BasicMatrix<T>::getData() const
 {
     return data.data();
 }
 
-Matrix::~Matrix()
+template<typename T>
+T* BasicMatrix<T>::getData()
 {
+    return data.data();
 }
 
-Matrix Matrix::operator*(const Matrix& other) const
+template<typename T>
+BasicMatrix<kernels::accumulator_t<T>> BasicMatrix<T>::operator*(const BasicMatrix& other) const
 {
     if (cols != other.rows)
     {
@@ -46,122 +94,134 @@ Matrix Matrix::operator*(const Matrix& other) const
             std::to_string(other.rows));
     }
 
-    Matrix result(rows, other.cols);
-#pragma omp parallel for collapse(2)
-    for (int i = 0; i < rows; i++)
-    {
-        for (int j = 0; j < other.cols; j++)
-        {
-            double sum = 0;
-            for (int k = 0; k < cols; k++)
-            {
-                sum += (*this)(i, k) * other(k, j);
-            }
-            result(i, j) = sum;
-        }
-    }
+    BasicMatrix<accumulator_type> result(rows, other.cols);
+    gemm(result, *this, other);
     return result;
 }
 
-Matrix Matrix::operator+(const Matrix& other)
+template<typename T>
+BasicMatrix<kernels::accumulator_t<T>> BasicMatrix<T>::transposeMultiply(const BasicMatrix& other) const
 {
-    if (rows != other.rows || cols != other.cols)
-    {
-        throw std::invalid_argument(
-            "Cannot add matrices with incompatible dimensions" + std::to_string(cols) + " and " + std::to_string(
-                other.rows));
-    }
-
-    Matrix result(rows, cols);
-
-    for (int i = 0; i < rows; i++)
-    {
-        for (int j = 0; j < cols; j++)
-        {
-            result(i, j) = (*this)(i, j) + other(i, j);
-        }
-    }
-
+    BasicMatrix<accumulator_type> result(cols, other.cols);
+    gemm(result, *this, other, 1, 0, true, false);
     return result;
 }
 
-Matrix Matrix::transpose()
+template<typename T>
+BasicMatrix<kernels::accumulator_t<T>> BasicMatrix<T>::multiplyTranspose(const BasicMatrix& other) const
 {
-    Matrix result(cols, rows);
-#pragma omp for collapse(2)
-    for (int i = 0; i < rows; i++)
-    {
-        for (int j = 0; j < cols; j++)
-        {
-            result(j, i) = (*this)(i, j);
-        }
-    }
-
+    BasicMatrix<accumulator_type> result(rows, other.rows);
+    gemm(result, *this, other, 1, 0, false, true);
     return result;
 }
 
-Matrix Matrix::hadamardProduct(const Matrix& other)
+namespace
 {
-    if (rows != other.rows || cols != other.cols)
+    template<typename T, typename Acc>
+    void gemmInto(BasicMatrix<Acc>& C, const BasicMatrixView<T> A, const BasicMatrixView<T> B,
+                  const Acc alpha, const Acc beta, const bool transA, const bool transB,
+                  const kernels::GemmEpilogue<Acc>& epilogue)
     {
-        throw std::invalid_argument(
-            "Cannot perform Hadamard product on matrices with incompatible dimensions " +
-            std::to_string(rows) + "x" + std::to_string(cols) + " and " +
-            std::to_string(other.rows) + "x" + std::to_string(other.cols));
-    }
+        // The kernel reads row-major operands; a column-major X is the transpose of a row-major one
+        if (A.getLayout() == Layout::ColumnMajor)
+        {
+            gemmInto(C, A.transposed(), B, alpha, beta, !transA, transB, epilogue);
+            return;
+        }
+        if (B.getLayout() == Layout::ColumnMajor)
+        {
+            gemmInto(C, A, B.transposed(), alpha, beta, transA, !transB, epilogue);
+            return;
+        }
 
-    Matrix result(rows, other.cols);
+        const int m = transA ? A.getCols() : A.getRows();
+        const int k = transA ? A.getRows() : A.getCols();
+        const int kB = transB ? B.getCols() : B.getRows();
+        const int n = transB ? B.getRows() : B.getCols();
 
-#pragma omp for collapse(2)
-    for (int i = 0; i < rows; i++)
-    {
-        for (int j = 0; j < other.cols; j++)
+        if (k != kB)
+        {
+            throw std::invalid_argument(
+                "Cannot multiply matrices with incompatible dimensions " + std::to_string(k) + " and " +
+                std::to_string(kB));
+        }
+        if (C.getRows() != m || C.getCols() != n)
         {
-            result(i, j) = (*this)(i, j) * other(i, j);
+            throw std::invalid_argument(
+                "gemm output must be " + std::to_string(m) + "x" + std::to_string(n) + " but is " +
+                std::to_string(C.getRows()) + "x" + std::to_string(C.getCols()));
         }
+
+        kernels::gemm<T, Acc>(transA, transB, m, n, k,
+                              alpha, A.getData(), A.getLeadingDimension(),
+                              B.getData(), B.getLeadingDimension(),
+                              beta, C.getData(), C.getLeadingDimension(), epilogue);
     }
+}
 
-    return result;
+template<typename T, typename Acc>
+void gemm(BasicMatrix<Acc>& C, const BasicMatrixView<T> A, const BasicMatrixView<T> B,
+          const typename NonDeduced<Acc>::type alpha, const typename NonDeduced<Acc>::type beta,
+          const bool transA, const bool transB)
+{
+    gemmInto(C, A, B, alpha, beta, transA, transB, kernels::GemmEpilogue<Acc>{});
 }
 
-Matrix Matrix::operator*(const double scalar)
+template<typename T, typename Acc>
+void gemm(BasicMatrix<Acc>& C, const BasicMatrixView<T> A, const BasicMatrixView<T> B,
+          const kernels::GemmEpilogue<Acc>& epilogue, const bool transA, const bool transB)
 {
-    Matrix result(rows, cols);
+    gemmInto(C, A, B, Acc(1), Acc(0), transA, transB, epilogue);
+}
 
-    for (int i = 0; i < rows; i++)
+template<typename T>
+BasicMatrix<kernels::accumulator_t<T>> operator*(const BasicMatrixView<T> lhs, const BasicMatrixView<T> rhs)
+{
+    if (lhs.getCols() != rhs.getRows())
     {
-        for (int j = 0; j < cols; j++)
-        {
-            result(i, j) = (*this)(i, j) * scalar;
-        }
+        throw std::invalid_argument(
+            "Cannot multiply matrices with incompatible dimensions " + std::to_string(lhs.getCols()) + " and " +
+            std::to_string(rhs.getRows()));
     }
+
+    BasicMatrix<kernels::accumulator_t<T>> result(lhs.getRows(), rhs.getCols());
+    gemm(result, lhs, rhs);
     return result;
 }
 
-Matrix Matrix::operator+(const double scalar)
+template<typename T>
+BasicMatrix<T> BasicMatrix<T>::transpose()
 {
-    Matrix result(rows, cols);
-    for (int i = 0; i < rows; i++)
+    BasicMatrix result(cols, rows);
+    const size_t rowGrain = ParallelGrain::TRANSPOSE / std::max(cols, 1) + 1;
+    ThreadPool::global().parallelFor(0, rows, rowGrain, [&](const size_t first, const size_t last)
     {
-        for (int j = 0; j < cols; j++)
+        for (int i = static_cast<int>(first); i < static_cast<int>(last); i++)
         {
-            result(i, j) = (*this)(i, j) + scalar;
+            for (int j = 0; j < cols; j++)
+            {
+                result(j, i) = (*this)(i, j);
+            }
         }
-    }
+    });
+
     return result;
 }
 
-void Matrix::randomize(const double min, const double max)
+// Integer matrices draw from the same real distribution and round toward zero.
+template<typename T>
+void BasicMatrix<T>::randomize(const double min, const double max)
 {
     std::default_random_engine eng;
     std::uniform_real_distribution<double> distribution(min, max);
-    std::for_each(data.begin(), data.end(), [distribution, eng](double& elem) mutable
+    forEachSpanInOrder([&distribution, &eng](T* values, const size_t count, size_t)
     {
-        elem = distribution(eng);
+        std::generate(values, values + count, [&] { return static_cast<T>(distribution(eng)); });
     });
 }
 
-void Matrix::xavierInit()
+template<typename T>
+void BasicMatrix<T>::xavierInit()
 {
     const double fanIn = rows;
     const double fanOut = cols;
@@ -170,7 +230,8 @@ void Matrix::xavierInit()
     randomize(-sigma, sigma);
 }
 
-void Matrix::heInit()
+template<typename T>
+void BasicMatrix<T>::heInit()
 {
     const double fanIn = rows;
 
@@ -178,61 +239,153 @@ void Matrix::heInit()
 
     std::default_random_engine eng;
     std::normal_distribution<double> distribution(0, stdDeviation);
-    std::for_each(data.begin(), data.end(), [distribution, eng](double& elem) mutable
+    forEachSpanInOrder([&distribution, &eng](T* values, const size_t count, size_t)
     {
-        elem = distribution(eng);
+        std::generate(values, values + count, [&] { return static_cast<T>(distribution(eng)); });
     });
 }
 
-double Matrix::sum() const
+template<typename T>
+kernels::accumulator_t<T> BasicMatrix<T>::sum() const
 {
-    return std::accumulate(data.begin(), data.end(), 0.0);
+    return kernels::reduceSum(data.data(), rows, cols, ld);
 }
 
-double Matrix::mean() const
+template<typename T>
+double BasicMatrix<T>::mean() const
 {
-    if (data.empty())
+    const size_t count = static_cast<size_t>(rows) * cols;
+    if (count == 0)
         return 0.0;
-    return sum() / static_cast<double>(data.size());
+    return sum() / static_cast<double>(count);
+}
+
+template<typename T>
+BasicMatrix<kernels::accumulator_t<T>> BasicMatrix<T>::sumRows() const
+{
+    BasicMatrix<accumulator_type> result(rows, 1);
+    sumRows(result);
+    return result;
 }
 
-Matrix Matrix::sumRows() const
+template<typename T>
+void BasicMatrix<T>::sumRows(BasicMatrix<accumulator_type>& result) const
 {
-    Matrix result(rows, 1);
+    if (result.getRows() != rows || result.getCols() != 1)
+    {
+        throw std::invalid_argument("Row sums need a " + std::to_string(rows) + "x1 result");
+    }
 
-    for (int i = 0; i < rows; i++)
+    const size_t rowGrain = ParallelGrain::REDUCTION / std::max(cols, 1) + 1;
+    ThreadPool::global().parallelFor(0, rows, rowGrain, [&](const size_t first, const size_t last)
     {
-        for (int j = 0; j < cols; j++)
+        for (size_t i = first; i < last; i++)
         {
-            result(i, 0) += (*this)(i, j);
+            result(static_cast<int>(i), 0) = kernels::pairwiseSum(data.data() + i * ld, cols);
         }
-    }
+    });
+}
 
+template<typename T>
+BasicMatrix<T> BasicMatrix<T>::map(const std::function<T(T)>& func) const
+{
+    BasicMatrix result(*this);
+    result.applyFunction(func);
     return result;
 }
 
-Matrix& Matrix::operator=(const Matrix& m)
+template<typename T>
+void BasicMatrix<T>::applyFunction(const std::function<T(T)>& func)
 {
-    Matrix tmp(m);
-    std::swap(rows, tmp.rows);
-    std::swap(cols, tmp.cols);
-    std::swap(data, tmp.data);
+    forEachSpanInOrder([&func](T* values, const size_t count, size_t)
+    {
+        std::transform(values, values + count, values, func);
+    });
+}
+
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator*=(const T scalar)
+{
+    const auto& kernel = kernels::elementwise<T>();
+    forEachSpan([&kernel, scalar](T* values, const size_t count, size_t)
+    {
+        kernel.scale(values, scalar, values, count);
+    });
     return *this;
 }
 
-Matrix Matrix::map(const std::function<double(double)>& func) const
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator+=(const T scalar)
 {
-    Matrix result(*this);
-    std::transform(result.data.begin(), result.data.end(), result.data.begin(), func);
-    return result;
+    const auto& kernel = kernels::elementwise<T>();
+    forEachSpan([&kernel, scalar](T* values, const size_t count, size_t)
+    {
+        kernel.addScalar(values, scalar, values, count);
+    });
+    return *this;
+}
+
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::axpy(const T alpha, const BasicMatrix& x)
+{
+    requireSameShape(x.rows, x.cols, "add");
+    const auto& kernel = kernels::elementwise<T>();
+    forEachSpan(x, [&kernel, alpha](T* values, const T* operand, const size_t count)
+    {
+        kernel.axpy(alpha, operand, values, count);
+    });
+    return *this;
+}
+
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::hadamardInPlace(const BasicMatrix& other)
+{
+    requireSameShape(other.rows, other.cols, "perform Hadamard product on");
+    const auto& kernel = kernels::elementwise<T>();
+    forEachSpan(other, [&kernel](T* values, const T* operand, const size_t count)
+    {
+        kernel.mul(values, operand, values, count);
+    });
+    return *this;
+}
+
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::addToColumns(const BasicMatrix& column)
+{
+    if (column.rows != rows || column.cols != 1)
+    {
+        throw std::invalid_argument("Cannot add a " + std::to_string(column.rows) + "x" + std::to_string(column.cols) +
+                                    " column to every column of a matrix with " + std::to_string(rows) + " rows");
+    }
+    const auto& kernel = kernels::elementwise<T>();
+    for (int i = 0; i < rows; i++)
+    {
+        T* row = data.data() + static_cast<size_t>(i) * ld;
+        kernel.addScalar(row, column.data[static_cast<size_t>(i) * column.ld], row, cols);
+    }
+    return *this;
+}
+
+template<typename T>
+void BasicMatrix<T>::requireSameShape(const int otherRows, const int otherCols, const char* operation) const
+{
+    if (rows != otherRows || cols != otherCols)
+    {
+        throw std::invalid_argument(
+            std::string("Cannot ") + operation + " matrices with incompatible dimensions " +
+            std::to_string(rows) + "x" + std::to_string(cols) + " and " +
+            std::to_string(otherRows) + "x" + std::to_string(otherCols));
+    }
 }
 
-void Matrix::applyFunction(const std::function<double(double)>& func)
+template<typename T>
+void BasicMatrix<T>::evaluateInto(T* out) const
 {
-    std::transform(data.begin(), data.end(), data.begin(), func);
+    view().evaluateInto(out);
 }
 
-std::ostream& operator<<(std::ostream& os, const Matrix& matrix)
+template<typename T>
+std::ostream& operator<<(std::ostream& os, const BasicMatrix<T>& matrix)
 {
     os << "Matrix [" << matrix.getRows() << "x" << matrix.getCols() << "]:\n";
     for (int i = 0; i < matrix.getRows(); ++i)
@@ -240,7 +393,8 @@ std::ostream& operator<<(std::ostream& os, const Matrix& matrix)
         os << "[ ";
         for (int j = 0; j < matrix.getCols(); ++j)
         {
-            os << matrix(i, j);
+            // Unary plus promotes int8 so it prints as a number, not a character
+            os << +matrix(i, j);
             if (j < matrix.getRows() - 1)
                 os << ", ";
         }
@@ -250,47 +404,50 @@ std::ostream& operator<<(std::ostream& os, const Matrix& matrix)
     return os;
 }
 
-Matrix Matrix::operator-(const Matrix& other)
+template<typename T>
+BasicMatrixView<T> BasicMatrix<T>::view() const
 {
-    if (rows != other.rows || cols != other.cols)
-    {
-        throw std::invalid_argument(
-            "Cannot add matrices with incompatible dimensions" + std::to_string(cols) + " and " + std::to_string(
-                other.rows));
-    }
-
-    Matrix result(rows, cols);
-
-    for (int i = 0; i < rows; i++)
-    {
-        for (int j = 0; j < cols; j++)
-        {
-            result(i, j) = (*this)(i, j) - other(i, j);
-        }
-    }
-
-    return result;
+    return BasicMatrixView<T>(data.data(), rows, cols, ld);
 }
 
-Matrix Matrix::operator-(const Matrix& other) const
+template<typename T>
+BasicMatrixView<T> BasicMatrix<T>::col(const int idx) const
 {
-    Matrix result(rows, cols);
-    Matrix nonConstCopy(*this);
-    result = nonConstCopy - other;
+    return view().col(idx);
+}
 
-    return result;
+template<typename T>
+BasicMatrixView<T> BasicMatrix<T>::colRange(const int begin, const int end) const
+{
+    return view().colRange(begin, end);
 }
 
-Matrix Matrix::col(const int idx) const
+template<typename T>
+BasicMatrixView<T> BasicMatrix<T>::block(const int row, const int col, const int blockRows, const int blockCols) const
 {
-    if (idx < 0 || idx >= cols)
-    {
-        throw std::out_of_range("Column index out of range");
-    }
-    Matrix result(rows, 1);
-    for (int i = 0; i < rows; ++i)
-    {
-        result(i, 0) = (*this)(i, idx);
-    }
-    return result;
+    return view().block(row, col, blockRows, blockCols);
 }
+
+template class BasicMatrix<double>;
+template class BasicMatrix<float>;
+template class BasicMatrix<int8_t>;
+template class BasicMatrix<int32_t>;
+
+template void gemm<double, double>(Matrix&, MatrixView, MatrixView, double, double, bool, bool);
+template void gemm<float, float>(MatrixF&, MatrixViewF, MatrixViewF, float, float, bool, bool);
+template void gemm<int8_t, int32_t>(MatrixI32&, MatrixViewI8, MatrixViewI8, int32_t, int32_t, bool, bool);
+template void gemm<int32_t, int32_t>(MatrixI32&, MatrixViewI32, MatrixViewI32, int32_t, int32_t, bool, bool);
+template void gemm<double, double>(Matrix&, MatrixView, MatrixView, const kernels::GemmEpilogue<double>&, bool, bool);
+template void gemm<float, float>(MatrixF&, MatrixViewF, MatrixViewF, const kernels::GemmEpilogue<float>&, bool, bool);
+template void gemm<int8_t, int32_t>(MatrixI32&, MatrixViewI8, MatrixViewI8, const kernels::GemmEpilogue<int32_t>&, bool, bool);
+template void gemm<int32_t, int32_t>(MatrixI32&, MatrixViewI32, MatrixViewI32, const kernels::GemmEpilogue<int32_t>&, bool, bool);
+
+template Matrix operator*(MatrixView, MatrixView);
+template MatrixF operator*(MatrixViewF, MatrixViewF);
+template MatrixI32 operator*(MatrixViewI8, MatrixViewI8);
+template MatrixI32 operator*(MatrixViewI32, MatrixViewI32);
+
+template std::ostream& operator<<(std::ostream& os, const Matrix& matrix);
+template std::ostream& operator<<(std::ostream& os, const MatrixF& matrix);
+template std::ostream& operator<<(std::ostream& os, const MatrixI8& matrix);
+template std::ostream& operator<<(std::ostream& os, const MatrixI32& matrix);
@@ -0,0 +1,85 @@
+#include "MatrixView.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+template<typename T>
+BasicMatrixView<T> BasicMatrixView<T>::transposed() const
+{
+    return BasicMatrixView(data, cols, rows, ld, layout == Layout::RowMajor ? Layout::ColumnMajor : Layout::RowMajor);
+}
+
+template<typename T>
+BasicMatrixView<T> BasicMatrixView<T>::col(const int idx) const
+{
+    if (idx < 0 || idx >= cols)
+    {
+        throw std::out_of_range("Column index out of range");
+    }
+    if (layout == Layout::ColumnMajor)
+    {
+        // A stored column is contiguous: expose it as a packed row-major vector
+        return BasicMatrixView(data + static_cast<size_t>(idx) * ld, rows, 1, 1);
+    }
+    return BasicMatrixView(data + idx, rows, 1, ld);
+}
+
+template<typename T>
+BasicMatrixView<T> BasicMatrixView<T>::colRange(const int begin, const int end) const
+{
+    if (begin < 0 || end > cols || begin > end)
+    {
+        throw std::out_of_range("Column range out of range");
+    }
+    if (layout == Layout::ColumnMajor)
+    {
+        return BasicMatrixView(data + static_cast<size_t>(begin) * ld, rows, end - begin, ld, layout);
+    }
+    return BasicMatrixView(data + begin, rows, end - begin, ld);
+}
+
+template<typename T>
+BasicMatrixView<T> BasicMatrixView<T>::block(const int row, const int col, const int blockRows, const int blockCols) const
+{
+    if (row < 0 || col < 0 || blockRows < 0 || blockCols < 0 || row + blockRows > rows || col + blockCols > cols)
+    {
+        throw std::out_of_range("Block out of range");
+    }
+    if (layout == Layout::ColumnMajor)
+    {
+        return BasicMatrixView(data + static_cast<size_t>(col) * ld + row, blockRows, blockCols, ld, layout);
+    }
+    return BasicMatrixView(data + static_cast<size_t>(row) * ld + col, blockRows, blockCols, ld);
+}
+
+template<typename T>
+void BasicMatrixView<T>::evaluateInto(T* out) const
+{
+    if (isContiguous())
+    {
+        std::copy(data, data + static_cast<size_t>(rows) * cols, out);
+        return;
+    }
+    if (layout == Layout::ColumnMajor)
+    {
+        for (int i = 0; i < rows; i++)
+        {
+            for (int j = 0; j < cols; j++)
+            {
+                *out++ = data[static_cast<size_t>(j) * ld + i];
+            }
+        }
+        return;
+    }
+    for (int i = 0; i < rows; i++)
+    {
+        const T* row = data + static_cast<size_t>(i) * ld;
+        out = std::copy(row, row + cols, out);
+    }
+}
+
+template class BasicMatrixView<double>;
+template class BasicMatrixView<float>;
+template class BasicMatrixView<int8_t>;
+template class BasicMatrixView<int32_t>;
@@ -0,0 +1,70 @@
+#include "../include/Optimizer.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "../include/ThreadPool.h"
+
+template<typename T>
+void BasicOptimizer<T>::update(const size_t slot, BasicMatrix<T>& parameters, const BasicMatrix<T>& gradient,
+                               const T learningRate)
+{
+    const int rows = parameters.getRows();
+    const int cols = parameters.getCols();
+    if (gradient.getRows() != rows || gradient.getCols() != cols)
+    {
+        throw std::invalid_argument("Optimizer gradient must have the parameters' shape");
+    }
+    if (slot >= slots.size())
+    {
+        slots.resize(slot + 1);
+    }
+    std::vector<BasicMatrix<T>>& buffers = slots[slot];
+    if (buffers.empty() || buffers.front().getRows() != rows || buffers.front().getCols() != cols)
+    {
+        buffers.clear();
+        for (size_t k = 0; k < stateCount(); k++)
+        {
+            buffers.emplace_back(rows, cols);
+        }
+    }
+
+    // State buffers are always contiguous, so a flat span of the parameters and the
+    // gradient lines up with the same flat span of every buffer.
+    const auto run = [&](T* values, const T* g, const size_t offset, const size_t count)
+    {
+        T* state[MAX_STATE_BUFFERS] = {};
+        for (size_t k = 0; k < buffers.size(); k++)
+        {
+            state[k] = buffers[k].getData() + offset;
+        }
+        updateSpan(values, state, g, count, learningRate);
+    };
+    if (parameters.isContiguous() && gradient.isContiguous())
+    {
+        ThreadPool::global().parallelFor(0, static_cast<size_t>(rows) * cols, ParallelGrain::ELEMENTWISE,
+                                         [&](const size_t first, const size_t last)
+        {
+            run(parameters.getData() + first, gradient.getData() + first, first, last - first);
+        });
+        return;
+    }
+    ThreadPool::global().parallelFor(0, rows, ParallelGrain::ELEMENTWISE / std::max(cols, 1) + 1,
+                                     [&](const size_t first, const size_t last)
+    {
+        for (size_t r = first; r < last; r++)
+        {
+            run(parameters.getData() + r * parameters.getLeadingDimension(),
+                gradient.getData() + r * gradient.getLeadingDimension(), r * cols, cols);
+        }
+    });
+}
+
+template<typename T>
+void BasicOptimizer<T>::reset()
+{
+    slots.clear();
+}
+
+template class BasicOptimizer<double>;
+template class BasicOptimizer<float>;
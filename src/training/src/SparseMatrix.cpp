@@ -0,0 +1,200 @@
+#include "SparseMatrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    template<typename Acc>
+    void requireProductShape(const int m, const int k, const int kB, const int n, const BasicMatrix<Acc>& C)
+    {
+        if (k != kB)
+        {
+            throw std::invalid_argument(
+                "Cannot multiply matrices with incompatible dimensions " + std::to_string(k) + " and " +
+                std::to_string(kB));
+        }
+        if (C.getRows() != m || C.getCols() != n)
+        {
+            throw std::invalid_argument(
+                "gemm output must be " + std::to_string(m) + "x" + std::to_string(n) + " but is " +
+                std::to_string(C.getRows()) + "x" + std::to_string(C.getCols()));
+        }
+    }
+}
+
+template<typename T>
+BasicSparseMatrix<T>::BasicSparseMatrix(const int rows, const int cols, const Layout layout)
+    : rows(rows), cols(cols), layout(layout), pointers((layout == Layout::RowMajor ? rows : cols) + 1, 0)
+{
+}
+
+template<typename T>
+BasicSparseMatrix<T>::BasicSparseMatrix(const BasicMatrixView<T> dense, const Layout layout, const T threshold)
+    : rows(dense.getRows()), cols(dense.getCols()), layout(layout)
+{
+    const bool rowMajor = layout == Layout::RowMajor;
+    // Compared in double so that the magnitude of an int8 -128 does not wrap
+    const double cutoff = threshold;
+    const int major = rowMajor ? rows : cols;
+    const int minor = rowMajor ? cols : rows;
+    pointers.reserve(major + 1);
+    pointers.push_back(0);
+    for (int s = 0; s < major; s++)
+    {
+        for (int t = 0; t < minor; t++)
+        {
+            const T value = rowMajor ? dense(s, t) : dense(t, s);
+            if (std::abs(static_cast<double>(value)) > cutoff)
+            {
+                indices.push_back(t);
+                values.push_back(value);
+            }
+        }
+        pointers.push_back(static_cast<int>(values.size()));
+    }
+}
+
+template<typename T>
+BasicSparseMatrix<T>::BasicSparseMatrix(const int rows, const int cols, std::vector<int> pointers,
+                                        std::vector<int> indices, std::vector<T> values, const Layout layout)
+    : rows(rows), cols(cols), layout(layout), pointers(std::move(pointers)), indices(std::move(indices)),
+      values(std::move(values))
+{
+    const int major = layout == Layout::RowMajor ? rows : cols;
+    const int minor = layout == Layout::RowMajor ? cols : rows;
+    if (this->pointers.size() != static_cast<size_t>(major) + 1 || this->pointers.front() != 0 ||
+        static_cast<size_t>(this->pointers.back()) != this->values.size() ||
+        this->indices.size() != this->values.size())
+    {
+        throw std::invalid_argument("Compressed sparse arrays do not match the matrix dimensions");
+    }
+    for (int s = 0; s < major; s++)
+    {
+        if (this->pointers[s] > this->pointers[s + 1])
+        {
+            throw std::invalid_argument("Compressed sparse pointers must be non-decreasing");
+        }
+        for (int q = this->pointers[s]; q < this->pointers[s + 1]; q++)
+        {
+            const int index = this->indices[q];
+            if (index < 0 || index >= minor || (q > this->pointers[s] && index <= this->indices[q - 1]))
+            {
+                throw std::invalid_argument("Compressed sparse indices must be in range and strictly increasing");
+            }
+        }
+    }
+}
+
+template<typename T>
+double BasicSparseMatrix<T>::density() const
+{
+    const double total = static_cast<double>(rows) * cols;
+    return total == 0 ? 0.0 : static_cast<double>(values.size()) / total;
+}
+
+template<typename T>
+T BasicSparseMatrix<T>::operator()(const int row, const int col) const
+{
+    const int s = layout == Layout::RowMajor ? row : col;
+    const int t = layout == Layout::RowMajor ? col : row;
+    const auto begin = indices.begin() + pointers[s];
+    const auto end = indices.begin() + pointers[s + 1];
+    const auto it = std::lower_bound(begin, end, t);
+    return it != end && *it == t ? values[it - indices.begin()] : T(0);
+}
+
+template<typename T>
+BasicMatrix<T> BasicSparseMatrix<T>::toDense() const
+{
+    BasicMatrix<T> result(rows, cols);
+    const int major = layout == Layout::RowMajor ? rows : cols;
+    for (int s = 0; s < major; s++)
+    {
+        for (int q = pointers[s]; q < pointers[s + 1]; q++)
+        {
+            if (layout == Layout::RowMajor)
+                result(s, indices[q]) = values[q];
+            else
+                result(indices[q], s) = values[q];
+        }
+    }
+    return result;
+}
+
+template<typename T>
+BasicSparseMatrix<T> BasicSparseMatrix<T>::transposed() const
+{
+    return BasicSparseMatrix(cols, rows, pointers, indices, values,
+                             layout == Layout::RowMajor ? Layout::ColumnMajor : Layout::RowMajor);
+}
+
+template<typename T, typename Acc>
+void gemm(BasicMatrix<Acc>& C, const BasicSparseMatrix<T>& A, const typename NonDeduced<BasicMatrixView<T>>::type B,
+          const typename NonDeduced<Acc>::type alpha, const typename NonDeduced<Acc>::type beta)
+{
+    requireProductShape(A.getRows(), A.getCols(), B.getRows(), B.getCols(), C);
+    // The kernel reads row-major dense operands; a column-major B is a transposed row-major one
+    const bool transB = B.getLayout() == Layout::ColumnMajor;
+    const BasicMatrixView<T> stored = transB ? B.transposed() : B;
+    kernels::spmm<T, Acc>(A.getLayout() == Layout::ColumnMajor, transB, A.getRows(), B.getCols(), A.getCols(),
+                          alpha, A.compressed(), stored.getData(), stored.getLeadingDimension(),
+                          beta, C.getData(), C.getLeadingDimension());
+}
+
+template<typename T, typename Acc>
+void gemm(BasicMatrix<Acc>& C, const typename NonDeduced<BasicMatrixView<T>>::type A, const BasicSparseMatrix<T>& B,
+          const typename NonDeduced<Acc>::type alpha, const typename NonDeduced<Acc>::type beta)
+{
+    requireProductShape(A.getRows(), A.getCols(), B.getRows(), B.getCols(), C);
+    const bool transA = A.getLayout() == Layout::ColumnMajor;
+    const BasicMatrixView<T> stored = transA ? A.transposed() : A;
+    kernels::gemmSparse<T, Acc>(transA, B.getLayout() == Layout::ColumnMajor, A.getRows(), B.getCols(), A.getCols(),
+                                alpha, stored.getData(), stored.getLeadingDimension(), B.compressed(),
+                                beta, C.getData(), C.getLeadingDimension());
+}
+
+template<typename T>
+BasicMatrix<kernels::accumulator_t<T>> operator*(const BasicSparseMatrix<T>& lhs,
+                                                  const typename NonDeduced<BasicMatrixView<T>>::type rhs)
+{
+    BasicMatrix<kernels::accumulator_t<T>> result(lhs.getRows(), rhs.getCols());
+    gemm(result, lhs, rhs);
+    return result;
+}
+
+template<typename T>
+BasicMatrix<kernels::accumulator_t<T>> operator*(const typename NonDeduced<BasicMatrixView<T>>::type lhs,
+                                                  const BasicSparseMatrix<T>& rhs)
+{
+    BasicMatrix<kernels::accumulator_t<T>> result(lhs.getRows(), rhs.getCols());
+    gemm(result, lhs, rhs);
+    return result;
+}
+
+template class BasicSparseMatrix<double>;
+template class BasicSparseMatrix<float>;
+template class BasicSparseMatrix<int8_t>;
+template class BasicSparseMatrix<int32_t>;
+
+template void gemm<double, double>(Matrix&, const SparseMatrix&, MatrixView, double, double);
+template void gemm<float, float>(MatrixF&, const SparseMatrixF&, MatrixViewF, float, float);
+template void gemm<int8_t, int32_t>(MatrixI32&, const SparseMatrixI8&, MatrixViewI8, int32_t, int32_t);
+template void gemm<int32_t, int32_t>(MatrixI32&, const SparseMatrixI32&, MatrixViewI32, int32_t, int32_t);
+
+template void gemm<double, double>(Matrix&, MatrixView, const SparseMatrix&, double, double);
+template void gemm<float, float>(MatrixF&, MatrixViewF, const SparseMatrixF&, float, float);
+template void gemm<int8_t, int32_t>(MatrixI32&, MatrixViewI8, const SparseMatrixI8&, int32_t, int32_t);
+template void gemm<int32_t, int32_t>(MatrixI32&, MatrixViewI32, const SparseMatrixI32&, int32_t, int32_t);
+
+template Matrix operator*(const SparseMatrix&, MatrixView);
+template MatrixF operator*(const SparseMatrixF&, MatrixViewF);
+template MatrixI32 operator*(const SparseMatrixI8&, MatrixViewI8);
+template MatrixI32 operator*(const SparseMatrixI32&, MatrixViewI32);
+
+template Matrix operator*(MatrixView, const SparseMatrix&);
+template MatrixF operator*(MatrixViewF, const SparseMatrixF&);
+template MatrixI32 operator*(MatrixViewI8, const SparseMatrixI8&);
+template MatrixI32 operator*(MatrixViewI32, const SparseMatrixI32&);
@@ -0,0 +1,161 @@
+#include "ThreadPool.h"
+
+#include <cstdlib>
+
+#ifndef EDGEMLP_NUM_THREADS
+#define EDGEMLP_NUM_THREADS 0
+#endif
+
+namespace
+{
+    // Set on pool workers and on a caller while it runs chunks, so nested loops go serial.
+    thread_local bool insideParallelRegion = false;
+
+    // Marks the calling thread as inside a parallel region until the scope ends, however it ends.
+    class ParallelRegionScope
+    {
+    public:
+        ParallelRegionScope() { insideParallelRegion = true; }
+        ~ParallelRegionScope() { insideParallelRegion = false; }
+        ParallelRegionScope(const ParallelRegionScope&) = delete;
+        ParallelRegionScope& operator=(const ParallelRegionScope&) = delete;
+    };
+
+    // Function-local static initialisation is thread-safe, so threads making their
+    // first kernel call at the same time all see the one default pool.
+    std::unique_ptr<ThreadPool>& globalPool()
+    {
+        static std::unique_ptr<ThreadPool> pool = std::make_unique<ThreadPool>(ThreadPool::defaultThreadCount());
+        return pool;
+    }
+}
+
+ThreadPool::ThreadPool(const int threads)
+{
+    for (int i = 1; i < threads; i++)
+    {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::global()
+{
+    return *globalPool();
+}
+
+void ThreadPool::setGlobalThreadCount(const int threads)
+{
+    std::unique_ptr<ThreadPool>& pool = globalPool();
+    pool.reset();
+    pool = std::make_unique<ThreadPool>(threads > 0 ? threads : defaultThreadCount());
+}
+
+int ThreadPool::defaultThreadCount()
+{
+    if (const char* value = std::getenv("EDGEMLP_NUM_THREADS"))
+    {
+        const int threads = std::atoi(value);
+        if (threads > 0)
+            return threads;
+    }
+    if (EDGEMLP_NUM_THREADS > 0)
+        return EDGEMLP_NUM_THREADS;
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+void ThreadPool::run(const Task task, const void* context, const size_t count)
+{
+    std::unique_lock<std::mutex> submit(submitMutex, std::try_to_lock);
+    if (!submit.owns_lock() || workers.empty() || insideParallelRegion)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            task(context, i);
+        }
+        return;
+    }
+
+    {
+        // Wait for stragglers from the previous job before replacing it
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return active == 0; });
+        this->task = task;
+        this->context = context;
+        taskCount = count;
+        nextTask.store(0, std::memory_order_relaxed);
+        error = nullptr;
+        generation++;
+    }
+    wake.notify_all();
+
+    {
+        const ParallelRegionScope region;
+        drain();
+    }
+
+    // Every chunk has been claimed; wait for the workers still running theirs, whose
+    // context lives in the caller's frame, before passing on any exception
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return active == 0; });
+    if (error)
+    {
+        std::exception_ptr thrown = nullptr;
+        std::swap(thrown, error);
+        lock.unlock();
+        std::rethrow_exception(thrown);
+    }
+}
+
+void ThreadPool::drain()
+{
+    for (size_t i = nextTask.fetch_add(1); i < taskCount; i = nextTask.fetch_add(1))
+    {
+        try
+        {
+            task(context, i);
+        }
+        catch (...)
+        {
+            // Keep the first exception and leave the chunks nobody has started
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+            nextTask.store(taskCount);
+        }
+    }
+}
+
+void ThreadPool::workerLoop()
+{
+    insideParallelRegion = true;
+    size_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        wake.wait(lock, [this, &seen] { return stopping || generation != seen; });
+        if (stopping)
+            return;
+        seen = generation;
+        active++;
+        lock.unlock();
+        drain();
+        lock.lock();
+        if (--active == 0)
+            idle.notify_all();
+    }
+}
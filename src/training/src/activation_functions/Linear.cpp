@@ -1,18 +1,45 @@
 #include "../../include/activation_functions/Linear.h"
 
-double Linear::activate(double x)
+template<typename T>
+T BasicLinear<T>::activate(T x)
 {
     return x;
 }
 
-double Linear::derivative(double x)
+template<typename T>
+T BasicLinear<T>::derivative(T x)
 {
     return 1.0;
 }
 
-std::string Linear::name()
+// The identity leaves the values and the gradient unchanged.
+template<typename T>
+void BasicLinear<T>::forwardInPlace(T*, size_t)
+{
+}
+
+template<typename T>
+void BasicLinear<T>::backwardInPlace(T*, const T*, size_t)
+{
+}
+
+template<typename T>
+bool BasicLinear<T>::derivativeUsesOutput() const
+{
+    return true;
+}
+
+template<typename T>
+void BasicLinear<T>::backwardFromOutputInPlace(T*, const T*, size_t)
+{
+}
+
+template<typename T>
+std::string BasicLinear<T>::name()
 {
     return "Linear";
 }
 
+template class BasicLinear<double>;
+template class BasicLinear<float>;
 
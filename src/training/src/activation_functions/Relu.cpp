@@ -1,6 +1,7 @@
 #include "../../include/activation_functions/Relu.h"
 
-double Relu::activate(const double x)
+template<typename T>
+T BasicRelu<T>::activate(const T x)
 {
     if (x <= 0.0)
     {
@@ -9,7 +10,8 @@ double Relu::activate(const double x)
     return x;
 }
 
-double Relu::derivative(const double x)
+template<typename T>
+T BasicRelu<T>::derivative(const T x)
 {
     if (x <= 0.0)
     {
@@ -18,7 +20,36 @@ double Relu::derivative(const double x)
     return 1;
 }
 
-std::string Relu::name()
+template<typename T>
+void BasicRelu<T>::forwardInPlace(T* values, const size_t count)
+{
+    kernels::elementwise<T>().relu(values, values, count);
+}
+
+template<typename T>
+void BasicRelu<T>::backwardInPlace(T* gradient, const T* input, const size_t count)
+{
+    kernels::elementwise<T>().reluBackward(input, gradient, gradient, count);
+}
+
+// relu(x) <= 0 exactly when x <= 0, so the output selects the same gradients.
+template<typename T>
+bool BasicRelu<T>::derivativeUsesOutput() const
+{
+    return true;
+}
+
+template<typename T>
+void BasicRelu<T>::backwardFromOutputInPlace(T* gradient, const T* output, const size_t count)
+{
+    kernels::elementwise<T>().reluBackward(output, gradient, gradient, count);
+}
+
+template<typename T>
+std::string BasicRelu<T>::name()
 {
     return "ReLU";
 }
+
+template class BasicRelu<double>;
+template class BasicRelu<float>;
@@ -1,18 +1,91 @@
 #include "../../include/activation_functions/Sigmoid.h"
+#include <algorithm>
 #include <cmath>
+#include <iterator>
 
-double Sigmoid::activate(const double x)
+template<typename T>
+BasicSigmoid<T>::BasicSigmoid(const ActivationPrecision precision) : precision(precision)
 {
-    return std::exp(x) / (1+exp(x));
 }
 
-double Sigmoid::derivative(const double x)
+template<typename T>
+ActivationPrecision BasicSigmoid<T>::getPrecision() const
 {
-    return activate(x) * (1-activate(x));
+    return precision;
 }
 
-std::string Sigmoid::name()
+template<typename T>
+T BasicSigmoid<T>::activate(const T x)
+{
+    // Same value as exp(x) / (1 + exp(x)), without inf / inf for large x
+    return 1 / (1 + std::exp(-x));
+}
+
+template<typename T>
+T BasicSigmoid<T>::derivative(const T x)
+{
+    const T s = activate(x);
+    return s * (1 - s);
+}
+
+template<typename T>
+void BasicSigmoid<T>::forwardInPlace(T* values, const size_t count)
+{
+    if (precision == ActivationPrecision::Fast)
+    {
+        kernels::elementwise<T>().fastSigmoid(values, values, count);
+        return;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        values[i] = 1 / (1 + std::exp(-values[i]));
+    }
+}
+
+template<typename T>
+void BasicSigmoid<T>::backwardInPlace(T* gradient, const T* input, const size_t count)
+{
+    if (precision == ActivationPrecision::Fast)
+    {
+        // Evaluate the outputs a block at a time and reuse the output-based derivative
+        T outputs[256];
+        for (size_t first = 0; first < count; first += std::size(outputs))
+        {
+            const size_t block = std::min(count - first, std::size(outputs));
+            kernels::elementwise<T>().fastSigmoid(input + first, outputs, block);
+            backwardFromOutputInPlace(gradient + first, outputs, block);
+        }
+        return;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        const T s = 1 / (1 + std::exp(-input[i]));
+        gradient[i] *= s * (1 - s);
+    }
+}
+
+template<typename T>
+bool BasicSigmoid<T>::derivativeUsesOutput() const
+{
+    return true;
+}
+
+// sigmoid'(x) = s * (1 - s) with s = sigmoid(x), so no exp is needed.
+template<typename T>
+void BasicSigmoid<T>::backwardFromOutputInPlace(T* gradient, const T* output, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        gradient[i] *= output[i] * (1 - output[i]);
+    }
+}
+
+template<typename T>
+std::string BasicSigmoid<T>::name()
 {
     return "Sigmoid";
 }
 
+template class BasicSigmoid<double>;
+template class BasicSigmoid<float>;
+
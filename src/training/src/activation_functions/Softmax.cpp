@@ -0,0 +1,203 @@
+#include "../../include/activation_functions/Softmax.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    // Per-thread scratch of one entry per column, reused across calls so the
+    // column-wise passes do not allocate in the steady state.
+    template<typename T>
+    T* columnScratch(const size_t slot, const size_t count)
+    {
+        thread_local std::vector<T> buffers[2];
+        std::vector<T>& buffer = buffers[slot];
+        if (buffer.size() < count)
+        {
+            buffer.resize(count);
+        }
+        return buffer.data();
+    }
+}
+
+template<typename T>
+BasicSoftmax<T>::BasicSoftmax(const ActivationPrecision precision) : precision(precision)
+{
+}
+
+template<typename T>
+ActivationPrecision BasicSoftmax<T>::getPrecision() const
+{
+    return precision;
+}
+
+template<typename T>
+T BasicSoftmax<T>::activate(T)
+{
+    throw std::logic_error("Softmax normalises over a whole sample and has no scalar form");
+}
+
+template<typename T>
+T BasicSoftmax<T>::derivative(T)
+{
+    throw std::logic_error("Softmax normalises over a whole sample and has no scalar form");
+}
+
+template<typename T>
+void BasicSoftmax<T>::expInPlace(T* values, const size_t count) const
+{
+    if (precision == ActivationPrecision::Fast)
+    {
+        kernels::elementwise<T>().fastExp(values, values, count);
+        return;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        values[i] = std::exp(values[i]);
+    }
+}
+
+template<typename T>
+void BasicSoftmax<T>::forwardInPlace(T* values, const size_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    const auto& k = kernels::elementwise<T>();
+    const T maximum = *std::max_element(values, values + count);
+    k.addScalar(values, -maximum, values, count);
+    expInPlace(values, count);
+    // The largest term is exp(0) = 1, so the sum is at least 1
+    k.scale(values, T(1) / static_cast<T>(k.sum(values, count)), values, count);
+}
+
+template<typename T>
+void BasicSoftmax<T>::backwardInPlace(T* gradient, const T* input, const size_t count)
+{
+    T* output = columnScratch<T>(0, count);
+    std::copy(input, input + count, output);
+    forwardInPlace(output, count);
+    backwardFromOutputInPlace(gradient, output, count);
+}
+
+template<typename T>
+bool BasicSoftmax<T>::derivativeUsesOutput() const
+{
+    return true;
+}
+
+template<typename T>
+void BasicSoftmax<T>::backwardFromOutputInPlace(T* gradient, const T* output, const size_t count)
+{
+    T dot = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        dot += gradient[i] * output[i];
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        gradient[i] = output[i] * (gradient[i] - dot);
+    }
+}
+
+template<typename T>
+bool BasicSoftmax<T>::isElementwise() const
+{
+    return false;
+}
+
+// Samples are columns of a row-major matrix, so every pass walks the rows and
+// works on all columns at once: the loops run along contiguous memory and the
+// per-column maxima and sums are kept in scratch vectors.
+template<typename T>
+void BasicSoftmax<T>::forwardColumns(BasicMatrix<T>& values)
+{
+    const size_t rows = values.getRows();
+    const size_t cols = values.getCols();
+    const size_t ld = values.getLeadingDimension();
+    if (rows == 0 || cols == 0)
+    {
+        return;
+    }
+    T* data = values.getData();
+    if (cols == 1 && (ld == 1 || rows == 1))
+    {
+        forwardInPlace(data, rows);
+        return;
+    }
+
+    const auto& k = kernels::elementwise<T>();
+    T* maxima = columnScratch<T>(0, cols);
+    T* sums = columnScratch<T>(1, cols);
+    std::copy(data, data + cols, maxima);
+    for (size_t r = 1; r < rows; r++)
+    {
+        const T* row = data + r * ld;
+        for (size_t c = 0; c < cols; c++)
+        {
+            maxima[c] = std::max(maxima[c], row[c]);
+        }
+    }
+    std::fill(sums, sums + cols, T(0));
+    for (size_t r = 0; r < rows; r++)
+    {
+        T* row = data + r * ld;
+        k.sub(row, maxima, row, cols);
+        expInPlace(row, cols);
+        k.add(sums, row, sums, cols);
+    }
+    for (size_t c = 0; c < cols; c++)
+    {
+        sums[c] = T(1) / sums[c];
+    }
+    for (size_t r = 0; r < rows; r++)
+    {
+        T* row = data + r * ld;
+        k.mul(row, sums, row, cols);
+    }
+}
+
+template<typename T>
+void BasicSoftmax<T>::backwardColumnsFromOutput(BasicMatrix<T>& gradient, const BasicMatrix<T>& output)
+{
+    const size_t rows = gradient.getRows();
+    const size_t cols = gradient.getCols();
+    if (output.getRows() != gradient.getRows() || output.getCols() != gradient.getCols())
+    {
+        throw std::invalid_argument("Softmax output and gradient must have the same shape");
+    }
+    if (rows == 0 || cols == 0)
+    {
+        return;
+    }
+
+    const auto& k = kernels::elementwise<T>();
+    T* dots = columnScratch<T>(0, cols);
+    T* scratch = columnScratch<T>(1, cols);
+    std::fill(dots, dots + cols, T(0));
+    for (size_t r = 0; r < rows; r++)
+    {
+        const T* g = gradient.getData() + r * gradient.getLeadingDimension();
+        const T* p = output.getData() + r * output.getLeadingDimension();
+        k.mul(g, p, scratch, cols);
+        k.add(dots, scratch, dots, cols);
+    }
+    for (size_t r = 0; r < rows; r++)
+    {
+        T* g = gradient.getData() + r * gradient.getLeadingDimension();
+        const T* p = output.getData() + r * output.getLeadingDimension();
+        k.sub(g, dots, g, cols);
+        k.mul(g, p, g, cols);
+    }
+}
+
+template<typename T>
+std::string BasicSoftmax<T>::name()
+{
+    return "Softmax";
+}
+
+template class BasicSoftmax<double>;
+template class BasicSoftmax<float>;
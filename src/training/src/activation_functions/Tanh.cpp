@@ -1,20 +1,90 @@
 #include "../../include/activation_functions/Tanh.h"
+#include <algorithm>
 #include <cmath>
+#include <iterator>
 
-double Tanh::activate(const double x)
+template<typename T>
+BasicTanh<T>::BasicTanh(const ActivationPrecision precision) : precision(precision)
+{
+}
+
+template<typename T>
+ActivationPrecision BasicTanh<T>::getPrecision() const
+{
+    return precision;
+}
+
+template<typename T>
+T BasicTanh<T>::activate(const T x)
 {
     return std::tanh(x);
 }
 
-double Tanh::derivative(const double x)
+template<typename T>
+T BasicTanh<T>::derivative(const T x)
+{
+    const T y = std::tanh(x);
+    return 1 - (y*y);
+}
+
+template<typename T>
+void BasicTanh<T>::forwardInPlace(T* values, const size_t count)
+{
+    if (precision == ActivationPrecision::Fast)
+    {
+        kernels::elementwise<T>().fastTanh(values, values, count);
+        return;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        values[i] = std::tanh(values[i]);
+    }
+}
+
+template<typename T>
+void BasicTanh<T>::backwardInPlace(T* gradient, const T* input, const size_t count)
+{
+    if (precision == ActivationPrecision::Fast)
+    {
+        // Evaluate the outputs a block at a time and reuse the output-based derivative
+        T outputs[256];
+        for (size_t first = 0; first < count; first += std::size(outputs))
+        {
+            const size_t block = std::min(count - first, std::size(outputs));
+            kernels::elementwise<T>().fastTanh(input + first, outputs, block);
+            backwardFromOutputInPlace(gradient + first, outputs, block);
+        }
+        return;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        const T y = std::tanh(input[i]);
+        gradient[i] *= 1 - y * y;
+    }
+}
+
+template<typename T>
+bool BasicTanh<T>::derivativeUsesOutput() const
+{
+    return true;
+}
+
+// tanh'(x) = 1 - y^2 with y = tanh(x).
+template<typename T>
+void BasicTanh<T>::backwardFromOutputInPlace(T* gradient, const T* output, const size_t count)
 {
-    const double y = std::tanh(x);
-    return 1.0 - (y*y);
+    for (size_t i = 0; i < count; i++)
+    {
+        gradient[i] *= 1 - output[i] * output[i];
+    }
 }
 
-std::string Tanh::name()
+template<typename T>
+std::string BasicTanh<T>::name()
 {
     return "Hyperbolic tangent";
 }
 
+template class BasicTanh<double>;
+template class BasicTanh<float>;
 
@@ -0,0 +1,323 @@
+#include "../../include/kernels/Elementwise.h"
+#include "../../include/kernels/FastMath.h"
+#include "../../include/kernels/OptimizerMath.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+namespace
+{
+    // Reference implementations: every SIMD variant must match these up to summation order.
+    template<typename T>
+    void addScalarPath(const T* a, const T* b, T* out, const size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            out[i] = static_cast<T>(a[i] + b[i]);
+        }
+    }
+
+    template<typename T>
+    void subScalarPath(const T* a, const T* b, T* out, const size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            out[i] = static_cast<T>(a[i] - b[i]);
+        }
+    }
+
+    template<typename T>
+    void mulScalarPath(const T* a, const T* b, T* out, const size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            out[i] = static_cast<T>(a[i] * b[i]);
+        }
+    }
+
+    template<typename T>
+    void scaleScalarPath(const T* a, const T scalar, T* out, const size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            out[i] = static_cast<T>(a[i] * scalar);
+        }
+    }
+
+    template<typename T>
+    void addScalarScalarPath(const T* a, const T scalar, T* out, const size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            out[i] = static_cast<T>(a[i] + scalar);
+        }
+    }
+
+    // Four independent chains, like the SIMD variants, so the adds can overlap.
+    template<typename T>
+    kernels::accumulator_t<T> sumScalarPath(const T* a, const size_t n)
+    {
+        kernels::accumulator_t<T> s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            s0 += a[i];
+            s1 += a[i + 1];
+            s2 += a[i + 2];
+            s3 += a[i + 3];
+        }
+        for (; i < n; i++)
+        {
+            s0 += a[i];
+        }
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    template<typename T>
+    void axpyScalarPath(const T alpha, const T* x, T* y, const size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            y[i] = static_cast<T>(y[i] + alpha * x[i]);
+        }
+    }
+
+    template<typename T>
+    void reluScalarPath(const T* a, T* out, const size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            out[i] = a[i] <= 0 ? T(0) : a[i];
+        }
+    }
+
+    template<typename T>
+    void reluBackwardScalarPath(const T* a, const T* grad, T* out, const size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            out[i] = a[i] <= 0 ? T(0) : grad[i];
+        }
+    }
+
+    template<typename T>
+    void fastExpScalarPath(const T* a, T* out, const size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            out[i] = kernels::fastExp(a[i]);
+        }
+    }
+
+    template<typename T>
+    void fastSigmoidScalarPath(const T* a, T* out, const size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            out[i] = kernels::fastSigmoid(a[i]);
+        }
+    }
+
+    template<typename T>
+    void fastTanhScalarPath(const T* a, T* out, const size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            out[i] = kernels::fastTanh(a[i]);
+        }
+    }
+
+    template<typename T>
+    void momentumStepScalarPath(T* p, T* velocity, const T* g, const T lr, const T beta, const bool nesterov, const size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            kernels::momentumStep(p[i], velocity[i], g[i], lr, beta, nesterov);
+        }
+    }
+
+    template<typename T>
+    void adamStepScalarPath(T* p, T* m, T* v, const T* g, const kernels::AdamStep<T>& step, const size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            kernels::adamStep(p[i], m[i], v[i], g[i], step);
+        }
+    }
+
+    // The approximations only exist for floating-point element types.
+    template<typename T>
+    constexpr void (*fastExpPath())(const T*, T*, size_t)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            return fastExpScalarPath<T>;
+        }
+        return nullptr;
+    }
+
+    template<typename T>
+    constexpr void (*fastSigmoidPath())(const T*, T*, size_t)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            return fastSigmoidScalarPath<T>;
+        }
+        return nullptr;
+    }
+
+    template<typename T>
+    constexpr void (*fastTanhPath())(const T*, T*, size_t)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            return fastTanhScalarPath<T>;
+        }
+        return nullptr;
+    }
+
+    // Optimizer updates only exist for floating-point parameters.
+    template<typename T>
+    constexpr void (*momentumStepPath())(T*, T*, const T*, T, T, bool, size_t)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            return momentumStepScalarPath<T>;
+        }
+        return nullptr;
+    }
+
+    template<typename T>
+    constexpr void (*adamStepPath())(T*, T*, T*, const T*, const kernels::AdamStep<T>&, size_t)
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            return adamStepScalarPath<T>;
+        }
+        return nullptr;
+    }
+
+    template<typename T>
+    const kernels::ElementwiseKernels<T> SCALAR_KERNELS{
+        kernels::Isa::Scalar,
+        addScalarPath<T>,
+        subScalarPath<T>,
+        mulScalarPath<T>,
+        scaleScalarPath<T>,
+        addScalarScalarPath<T>,
+        sumScalarPath<T>,
+        axpyScalarPath<T>,
+        reluScalarPath<T>,
+        reluBackwardScalarPath<T>,
+        fastExpPath<T>(),
+        fastSigmoidPath<T>(),
+        fastTanhPath<T>(),
+        momentumStepPath<T>(),
+        adamStepPath<T>(),
+    };
+
+    bool cpuSupports(const kernels::Isa isa)
+    {
+#ifdef EDGEMLP_X86_SIMD
+        switch (isa)
+        {
+        case kernels::Isa::Scalar:
+            return true;
+        case kernels::Isa::Avx2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case kernels::Isa::Avx512:
+            return __builtin_cpu_supports("avx512f");
+        }
+        return false;
+#else
+        return isa == kernels::Isa::Scalar;
+#endif
+    }
+}
+
+namespace kernels
+{
+    Isa detectIsa()
+    {
+        Isa best = Isa::Scalar;
+        if (cpuSupports(Isa::Avx512))
+        {
+            best = Isa::Avx512;
+        }
+        else if (cpuSupports(Isa::Avx2))
+        {
+            best = Isa::Avx2;
+        }
+
+        const char* requested = std::getenv("EDGEMLP_ISA");
+        if (requested != nullptr)
+        {
+            if (std::strcmp(requested, "scalar") == 0)
+            {
+                best = Isa::Scalar;
+            }
+            else if (std::strcmp(requested, "avx2") == 0 && best == Isa::Avx512)
+            {
+                best = Isa::Avx2;
+            }
+        }
+        return best;
+    }
+
+    template<typename T>
+    const ElementwiseKernels<T>* elementwiseFor(const Isa isa)
+    {
+        if (!cpuSupports(isa))
+        {
+            return nullptr;
+        }
+#ifdef EDGEMLP_X86_SIMD
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            switch (isa)
+            {
+            case Isa::Avx2:
+                return &elementwiseAvx2<T>();
+            case Isa::Avx512:
+                return &elementwiseAvx512<T>();
+            default:
+                break;
+            }
+        }
+#endif
+        return isa == Isa::Scalar ? &SCALAR_KERNELS<T> : nullptr;
+    }
+
+    template<typename T>
+    const ElementwiseKernels<T>& elementwise()
+    {
+        static const ElementwiseKernels<T>& active = [] {
+            const ElementwiseKernels<T>* best = elementwiseFor<T>(detectIsa());
+            return best != nullptr ? *best : SCALAR_KERNELS<T>;
+        }();
+        return active;
+    }
+
+    const char* isaName(const Isa isa)
+    {
+        switch (isa)
+        {
+        case Isa::Avx2:
+            return "AVX2";
+        case Isa::Avx512:
+            return "AVX-512";
+        default:
+            return "Scalar";
+        }
+    }
+
+    template const ElementwiseKernels<double>& elementwise<double>();
+    template const ElementwiseKernels<float>& elementwise<float>();
+    template const ElementwiseKernels<int32_t>& elementwise<int32_t>();
+    template const ElementwiseKernels<int8_t>& elementwise<int8_t>();
+    template const ElementwiseKernels<double>* elementwiseFor<double>(Isa);
+    template const ElementwiseKernels<float>* elementwiseFor<float>(Isa);
+    template const ElementwiseKernels<int32_t>* elementwiseFor<int32_t>(Isa);
+    template const ElementwiseKernels<int8_t>* elementwiseFor<int8_t>(Isa);
+}
@@ -0,0 +1,393 @@
+#include "../../include/kernels/Elementwise.h"
+#include "../../include/kernels/FastMath.h"
+#include "../../include/kernels/OptimizerMath.h"
+
+#ifdef EDGEMLP_X86_SIMD
+
+#include <immintrin.h>
+#include <type_traits>
+
+#define EDGEMLP_AVX2 __attribute__((target("avx2,fma")))
+
+namespace
+{
+    // Thin wrappers so each kernel is written once for both lane types.
+    struct Lanes64
+    {
+        using T = double;
+        using V = __m256d;
+        static constexpr size_t WIDTH = 4;
+        EDGEMLP_AVX2 static V load(const T* p) { return _mm256_loadu_pd(p); }
+        EDGEMLP_AVX2 static void store(T* p, const V v) { _mm256_storeu_pd(p, v); }
+        EDGEMLP_AVX2 static V set1(const T x) { return _mm256_set1_pd(x); }
+        EDGEMLP_AVX2 static V zero() { return _mm256_setzero_pd(); }
+        EDGEMLP_AVX2 static V add(const V a, const V b) { return _mm256_add_pd(a, b); }
+        EDGEMLP_AVX2 static V sub(const V a, const V b) { return _mm256_sub_pd(a, b); }
+        EDGEMLP_AVX2 static V mul(const V a, const V b) { return _mm256_mul_pd(a, b); }
+        EDGEMLP_AVX2 static V fmadd(const V a, const V b, const V c) { return _mm256_fmadd_pd(a, b, c); }
+        EDGEMLP_AVX2 static V fnmadd(const V a, const V b, const V c) { return _mm256_fnmadd_pd(a, b, c); }
+        EDGEMLP_AVX2 static V div(const V a, const V b) { return _mm256_div_pd(a, b); }
+        EDGEMLP_AVX2 static V sqrt(const V a) { return _mm256_sqrt_pd(a); }
+        // NaN in b is returned unchanged
+        EDGEMLP_AVX2 static V min(const V a, const V b) { return _mm256_min_pd(a, b); }
+        EDGEMLP_AVX2 static V max(const V a, const V b) { return _mm256_max_pd(a, b); }
+        // 2^n from kd = n + FastExp::SHIFT
+        EDGEMLP_AVX2 static V exp2Shifted(const V kd)
+        {
+            const __m256i bits = _mm256_add_epi64(_mm256_castpd_si256(kd), _mm256_set1_epi64x(1023));
+            return _mm256_castsi256_pd(_mm256_slli_epi64(bits, 52));
+        }
+        // v where x > 0 or x is NaN, zero where x <= 0
+        EDGEMLP_AVX2 static V zeroWhereNotPositive(const V x, const V v)
+        {
+            return _mm256_andnot_pd(_mm256_cmp_pd(x, zero(), _CMP_LE_OQ), v);
+        }
+    };
+
+    struct Lanes32
+    {
+        using T = float;
+        using V = __m256;
+        static constexpr size_t WIDTH = 8;
+        EDGEMLP_AVX2 static V load(const T* p) { return _mm256_loadu_ps(p); }
+        EDGEMLP_AVX2 static void store(T* p, const V v) { _mm256_storeu_ps(p, v); }
+        EDGEMLP_AVX2 static V set1(const T x) { return _mm256_set1_ps(x); }
+        EDGEMLP_AVX2 static V zero() { return _mm256_setzero_ps(); }
+        EDGEMLP_AVX2 static V add(const V a, const V b) { return _mm256_add_ps(a, b); }
+        EDGEMLP_AVX2 static V sub(const V a, const V b) { return _mm256_sub_ps(a, b); }
+        EDGEMLP_AVX2 static V mul(const V a, const V b) { return _mm256_mul_ps(a, b); }
+        EDGEMLP_AVX2 static V fmadd(const V a, const V b, const V c) { return _mm256_fmadd_ps(a, b, c); }
+        EDGEMLP_AVX2 static V fnmadd(const V a, const V b, const V c) { return _mm256_fnmadd_ps(a, b, c); }
+        EDGEMLP_AVX2 static V div(const V a, const V b) { return _mm256_div_ps(a, b); }
+        EDGEMLP_AVX2 static V sqrt(const V a) { return _mm256_sqrt_ps(a); }
+        EDGEMLP_AVX2 static V min(const V a, const V b) { return _mm256_min_ps(a, b); }
+        EDGEMLP_AVX2 static V max(const V a, const V b) { return _mm256_max_ps(a, b); }
+        EDGEMLP_AVX2 static V exp2Shifted(const V kd)
+        {
+            const __m256i bits = _mm256_add_epi32(_mm256_castps_si256(kd), _mm256_set1_epi32(127));
+            return _mm256_castsi256_ps(_mm256_slli_epi32(bits, 23));
+        }
+        EDGEMLP_AVX2 static V zeroWhereNotPositive(const V x, const V v)
+        {
+            return _mm256_andnot_ps(_mm256_cmp_ps(x, zero(), _CMP_LE_OQ), v);
+        }
+    };
+
+    template<typename L>
+    EDGEMLP_AVX2 void add(const typename L::T* a, const typename L::T* b, typename L::T* out, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, L::add(L::load(a + i), L::load(b + i)));
+        }
+        for (; i < n; i++)
+        {
+            out[i] = a[i] + b[i];
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX2 void sub(const typename L::T* a, const typename L::T* b, typename L::T* out, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, L::sub(L::load(a + i), L::load(b + i)));
+        }
+        for (; i < n; i++)
+        {
+            out[i] = a[i] - b[i];
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX2 void mul(const typename L::T* a, const typename L::T* b, typename L::T* out, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, L::mul(L::load(a + i), L::load(b + i)));
+        }
+        for (; i < n; i++)
+        {
+            out[i] = a[i] * b[i];
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX2 void scale(const typename L::T* a, const typename L::T scalar, typename L::T* out, const size_t n)
+    {
+        const typename L::V s = L::set1(scalar);
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, L::mul(L::load(a + i), s));
+        }
+        for (; i < n; i++)
+        {
+            out[i] = a[i] * scalar;
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX2 void addScalar(const typename L::T* a, const typename L::T scalar, typename L::T* out, const size_t n)
+    {
+        const typename L::V s = L::set1(scalar);
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, L::add(L::load(a + i), s));
+        }
+        for (; i < n; i++)
+        {
+            out[i] = a[i] + scalar;
+        }
+    }
+
+    // Four independent accumulators hide the add latency.
+    template<typename L>
+    EDGEMLP_AVX2 typename L::T sum(const typename L::T* a, const size_t n)
+    {
+        typename L::V acc0 = L::zero();
+        typename L::V acc1 = L::zero();
+        typename L::V acc2 = L::zero();
+        typename L::V acc3 = L::zero();
+        size_t i = 0;
+        for (; i + 4 * L::WIDTH <= n; i += 4 * L::WIDTH)
+        {
+            acc0 = L::add(acc0, L::load(a + i));
+            acc1 = L::add(acc1, L::load(a + i + L::WIDTH));
+            acc2 = L::add(acc2, L::load(a + i + 2 * L::WIDTH));
+            acc3 = L::add(acc3, L::load(a + i + 3 * L::WIDTH));
+        }
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            acc0 = L::add(acc0, L::load(a + i));
+        }
+        typename L::T lanes[L::WIDTH];
+        L::store(lanes, L::add(L::add(acc0, acc1), L::add(acc2, acc3)));
+        typename L::T total = 0;
+        for (size_t lane = 0; lane < L::WIDTH; lane++)
+        {
+            total += lanes[lane];
+        }
+        for (; i < n; i++)
+        {
+            total += a[i];
+        }
+        return total;
+    }
+
+    template<typename L>
+    EDGEMLP_AVX2 void axpy(const typename L::T alpha, const typename L::T* x, typename L::T* y, const size_t n)
+    {
+        const typename L::V a = L::set1(alpha);
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(y + i, L::fmadd(a, L::load(x + i), L::load(y + i)));
+        }
+        for (; i < n; i++)
+        {
+            y[i] += alpha * x[i];
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX2 void relu(const typename L::T* a, typename L::T* out, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            const typename L::V x = L::load(a + i);
+            L::store(out + i, L::zeroWhereNotPositive(x, x));
+        }
+        for (; i < n; i++)
+        {
+            out[i] = a[i] <= 0 ? 0 : a[i];
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX2 void reluBackward(const typename L::T* a, const typename L::T* grad, typename L::T* out, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, L::zeroWhereNotPositive(L::load(a + i), L::load(grad + i)));
+        }
+        for (; i < n; i++)
+        {
+            out[i] = a[i] <= 0 ? 0 : grad[i];
+        }
+    }
+
+    // kernels::fastExp on a whole vector.
+    template<typename L>
+    EDGEMLP_AVX2 typename L::V expVector(typename L::V x)
+    {
+        using C = kernels::FastExp<typename L::T>;
+        x = L::max(L::set1(-C::CLAMP), L::min(L::set1(C::CLAMP), x));
+        const typename L::V kd = L::fmadd(x, L::set1(C::LOG2E), L::set1(C::SHIFT));
+        const typename L::V n = L::sub(kd, L::set1(C::SHIFT));
+        typename L::V r = L::fnmadd(n, L::set1(C::LN2_HI), x);
+        r = L::fnmadd(n, L::set1(C::LN2_LO), r);
+        typename L::V p = L::set1(C::COEFFICIENTS[C::DEGREE]);
+        for (int k = C::DEGREE - 1; k >= 0; k--)
+        {
+            p = L::fmadd(p, r, L::set1(C::COEFFICIENTS[k]));
+        }
+        return L::mul(p, L::exp2Shifted(kd));
+    }
+
+    template<typename L>
+    EDGEMLP_AVX2 typename L::V sigmoidVector(const typename L::V x)
+    {
+        const typename L::V one = L::set1(1);
+        return L::div(one, L::add(one, expVector<L>(L::sub(L::zero(), x))));
+    }
+
+    template<typename L>
+    EDGEMLP_AVX2 typename L::V tanhVector(const typename L::V x)
+    {
+        const typename L::V one = L::set1(1);
+        return L::sub(one, L::div(L::set1(2), L::add(one, expVector<L>(L::add(x, x)))));
+    }
+
+    template<typename L>
+    EDGEMLP_AVX2 void fastExp(const typename L::T* a, typename L::T* out, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, expVector<L>(L::load(a + i)));
+        }
+        for (; i < n; i++)
+        {
+            out[i] = kernels::fastExp(a[i]);
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX2 void fastSigmoid(const typename L::T* a, typename L::T* out, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, sigmoidVector<L>(L::load(a + i)));
+        }
+        for (; i < n; i++)
+        {
+            out[i] = kernels::fastSigmoid(a[i]);
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX2 void fastTanh(const typename L::T* a, typename L::T* out, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, tanhVector<L>(L::load(a + i)));
+        }
+        for (; i < n; i++)
+        {
+            out[i] = kernels::fastTanh(a[i]);
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX2 void momentumVector(typename L::V& p, typename L::V& velocity, const typename L::V g,
+                                   const typename L::V lr, const typename L::V beta, const bool nesterov)
+    {
+        velocity = L::fmadd(beta, velocity, g);
+        p = L::fnmadd(lr, nesterov ? L::fmadd(beta, velocity, g) : velocity, p);
+    }
+
+    template<typename L>
+    EDGEMLP_AVX2 void momentumStep(typename L::T* p, typename L::T* velocity, const typename L::T* g,
+                                 const typename L::T lr, const typename L::T beta, const bool nesterov, const size_t n)
+    {
+        const typename L::V rate = L::set1(lr);
+        const typename L::V b = L::set1(beta);
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            typename L::V vel = L::load(velocity + i);
+            typename L::V param = L::load(p + i);
+            momentumVector<L>(param, vel, L::load(g + i), rate, b, nesterov);
+            L::store(velocity + i, vel);
+            L::store(p + i, param);
+        }
+        for (; i < n; i++)
+        {
+            kernels::momentumStep(p[i], velocity[i], g[i], lr, beta, nesterov);
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX2 void adamVector(typename L::V& p, typename L::V& m, typename L::V& v, const typename L::V g,
+                               const kernels::AdamStep<typename L::T>& step)
+    {
+        m = L::fmadd(L::set1(step.beta1), m, L::mul(L::set1(1 - step.beta1), g));
+        v = L::fmadd(L::set1(step.beta2), v, L::mul(L::set1(1 - step.beta2), L::mul(g, g)));
+        p = L::fnmadd(L::set1(step.decay), p, p);
+        const typename L::V denominator = L::add(L::sqrt(L::mul(v, L::set1(step.secondMomentScale))), L::set1(step.epsilon));
+        p = L::fnmadd(L::set1(step.stepSize), L::div(m, denominator), p);
+    }
+
+    template<typename L>
+    EDGEMLP_AVX2 void adamStep(typename L::T* p, typename L::T* m, typename L::T* v, const typename L::T* g,
+                             const kernels::AdamStep<typename L::T>& step, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            typename L::V param = L::load(p + i);
+            typename L::V first = L::load(m + i);
+            typename L::V second = L::load(v + i);
+            adamVector<L>(param, first, second, L::load(g + i), step);
+            L::store(m + i, first);
+            L::store(v + i, second);
+            L::store(p + i, param);
+        }
+        for (; i < n; i++)
+        {
+            kernels::adamStep(p[i], m[i], v[i], g[i], step);
+        }
+    }
+
+    template<typename L>
+    const kernels::ElementwiseKernels<typename L::T> AVX2_KERNELS{
+        kernels::Isa::Avx2,
+        add<L>,
+        sub<L>,
+        mul<L>,
+        scale<L>,
+        addScalar<L>,
+        sum<L>,
+        axpy<L>,
+        relu<L>,
+        reluBackward<L>,
+        fastExp<L>,
+        fastSigmoid<L>,
+        fastTanh<L>,
+        momentumStep<L>,
+        adamStep<L>,
+    };
+}
+
+namespace kernels
+{
+    template<typename T>
+    const ElementwiseKernels<T>& elementwiseAvx2()
+    {
+        return AVX2_KERNELS<std::conditional_t<std::is_same_v<T, double>, Lanes64, Lanes32>>;
+    }
+
+    template const ElementwiseKernels<double>& elementwiseAvx2<double>();
+    template const ElementwiseKernels<float>& elementwiseAvx2<float>();
+}
+
+#endif
@@ -0,0 +1,430 @@
+#include "../../include/kernels/Elementwise.h"
+#include "../../include/kernels/FastMath.h"
+#include "../../include/kernels/OptimizerMath.h"
+
+#ifdef EDGEMLP_X86_SIMD
+
+#include <immintrin.h>
+#include <type_traits>
+
+#define EDGEMLP_AVX512 __attribute__((target("avx512f")))
+
+namespace
+{
+    // Thin wrappers so each kernel is written once for both lane types.
+    // Tails are handled with masked loads/stores instead of a scalar loop.
+    struct Lanes64
+    {
+        using T = double;
+        using V = __m512d;
+        using Mask = __mmask8;
+        static constexpr size_t WIDTH = 8;
+        // The unmasked forms of a few intrinsics pass an undefined vector through,
+        // which GCC reports as maybe-uninitialized; the all-lanes masked forms do not.
+        static constexpr Mask ALL = 0xFF;
+        EDGEMLP_AVX512 static Mask tail(const size_t n) { return static_cast<Mask>((1u << n) - 1u); }
+        EDGEMLP_AVX512 static V load(const T* p) { return _mm512_loadu_pd(p); }
+        EDGEMLP_AVX512 static V load(const Mask m, const T* p) { return _mm512_maskz_loadu_pd(m, p); }
+        EDGEMLP_AVX512 static void store(T* p, const V v) { _mm512_storeu_pd(p, v); }
+        EDGEMLP_AVX512 static void store(T* p, const Mask m, const V v) { _mm512_mask_storeu_pd(p, m, v); }
+        EDGEMLP_AVX512 static V set1(const T x) { return _mm512_set1_pd(x); }
+        EDGEMLP_AVX512 static V zero() { return _mm512_setzero_pd(); }
+        EDGEMLP_AVX512 static V add(const V a, const V b) { return _mm512_add_pd(a, b); }
+        EDGEMLP_AVX512 static V sub(const V a, const V b) { return _mm512_sub_pd(a, b); }
+        EDGEMLP_AVX512 static V mul(const V a, const V b) { return _mm512_mul_pd(a, b); }
+        EDGEMLP_AVX512 static V fmadd(const V a, const V b, const V c) { return _mm512_fmadd_pd(a, b, c); }
+        EDGEMLP_AVX512 static V fnmadd(const V a, const V b, const V c) { return _mm512_fnmadd_pd(a, b, c); }
+        EDGEMLP_AVX512 static V div(const V a, const V b) { return _mm512_div_pd(a, b); }
+        EDGEMLP_AVX512 static V sqrt(const V a) { return _mm512_maskz_sqrt_pd(ALL, a); }
+        // NaN in b is returned unchanged
+        EDGEMLP_AVX512 static V min(const V a, const V b) { return _mm512_maskz_min_pd(ALL, a, b); }
+        EDGEMLP_AVX512 static V max(const V a, const V b) { return _mm512_maskz_max_pd(ALL, a, b); }
+        // 2^n from kd = n + FastExp::SHIFT
+        EDGEMLP_AVX512 static V exp2Shifted(const V kd)
+        {
+            const __m512i bits = _mm512_add_epi64(_mm512_castpd_si512(kd), _mm512_set1_epi64(1023));
+            return _mm512_castsi512_pd(_mm512_maskz_slli_epi64(ALL, bits, 52));
+        }
+        // v where x > 0 or x is NaN, zero where x <= 0
+        EDGEMLP_AVX512 static V zeroWhereNotPositive(const V x, const V v)
+        {
+            return _mm512_mask_mov_pd(v, _mm512_cmp_pd_mask(x, zero(), _CMP_LE_OQ), zero());
+        }
+    };
+
+    struct Lanes32
+    {
+        using T = float;
+        using V = __m512;
+        using Mask = __mmask16;
+        static constexpr size_t WIDTH = 16;
+        static constexpr Mask ALL = 0xFFFF;
+        EDGEMLP_AVX512 static Mask tail(const size_t n) { return static_cast<Mask>((1u << n) - 1u); }
+        EDGEMLP_AVX512 static V load(const T* p) { return _mm512_loadu_ps(p); }
+        EDGEMLP_AVX512 static V load(const Mask m, const T* p) { return _mm512_maskz_loadu_ps(m, p); }
+        EDGEMLP_AVX512 static void store(T* p, const V v) { _mm512_storeu_ps(p, v); }
+        EDGEMLP_AVX512 static void store(T* p, const Mask m, const V v) { _mm512_mask_storeu_ps(p, m, v); }
+        EDGEMLP_AVX512 static V set1(const T x) { return _mm512_set1_ps(x); }
+        EDGEMLP_AVX512 static V zero() { return _mm512_setzero_ps(); }
+        EDGEMLP_AVX512 static V add(const V a, const V b) { return _mm512_add_ps(a, b); }
+        EDGEMLP_AVX512 static V sub(const V a, const V b) { return _mm512_sub_ps(a, b); }
+        EDGEMLP_AVX512 static V mul(const V a, const V b) { return _mm512_mul_ps(a, b); }
+        EDGEMLP_AVX512 static V fmadd(const V a, const V b, const V c) { return _mm512_fmadd_ps(a, b, c); }
+        EDGEMLP_AVX512 static V fnmadd(const V a, const V b, const V c) { return _mm512_fnmadd_ps(a, b, c); }
+        EDGEMLP_AVX512 static V div(const V a, const V b) { return _mm512_div_ps(a, b); }
+        EDGEMLP_AVX512 static V sqrt(const V a) { return _mm512_maskz_sqrt_ps(ALL, a); }
+        EDGEMLP_AVX512 static V min(const V a, const V b) { return _mm512_maskz_min_ps(ALL, a, b); }
+        EDGEMLP_AVX512 static V max(const V a, const V b) { return _mm512_maskz_max_ps(ALL, a, b); }
+        EDGEMLP_AVX512 static V exp2Shifted(const V kd)
+        {
+            const __m512i bits = _mm512_add_epi32(_mm512_castps_si512(kd), _mm512_set1_epi32(127));
+            return _mm512_castsi512_ps(_mm512_maskz_slli_epi32(ALL, bits, 23));
+        }
+        EDGEMLP_AVX512 static V zeroWhereNotPositive(const V x, const V v)
+        {
+            return _mm512_mask_mov_ps(v, _mm512_cmp_ps_mask(x, zero(), _CMP_LE_OQ), zero());
+        }
+    };
+
+    template<typename L>
+    EDGEMLP_AVX512 void add(const typename L::T* a, const typename L::T* b, typename L::T* out, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, L::add(L::load(a + i), L::load(b + i)));
+        }
+        if (i < n)
+        {
+            const typename L::Mask m = L::tail(n - i);
+            L::store(out + i, m, L::add(L::load(m, a + i), L::load(m, b + i)));
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX512 void sub(const typename L::T* a, const typename L::T* b, typename L::T* out, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, L::sub(L::load(a + i), L::load(b + i)));
+        }
+        if (i < n)
+        {
+            const typename L::Mask m = L::tail(n - i);
+            L::store(out + i, m, L::sub(L::load(m, a + i), L::load(m, b + i)));
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX512 void mul(const typename L::T* a, const typename L::T* b, typename L::T* out, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, L::mul(L::load(a + i), L::load(b + i)));
+        }
+        if (i < n)
+        {
+            const typename L::Mask m = L::tail(n - i);
+            L::store(out + i, m, L::mul(L::load(m, a + i), L::load(m, b + i)));
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX512 void scale(const typename L::T* a, const typename L::T scalar, typename L::T* out, const size_t n)
+    {
+        const typename L::V s = L::set1(scalar);
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, L::mul(L::load(a + i), s));
+        }
+        if (i < n)
+        {
+            const typename L::Mask m = L::tail(n - i);
+            L::store(out + i, m, L::mul(L::load(m, a + i), s));
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX512 void addScalar(const typename L::T* a, const typename L::T scalar, typename L::T* out, const size_t n)
+    {
+        const typename L::V s = L::set1(scalar);
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, L::add(L::load(a + i), s));
+        }
+        if (i < n)
+        {
+            const typename L::Mask m = L::tail(n - i);
+            L::store(out + i, m, L::add(L::load(m, a + i), s));
+        }
+    }
+
+    // Four independent accumulators hide the add latency.
+    template<typename L>
+    EDGEMLP_AVX512 typename L::T sum(const typename L::T* a, const size_t n)
+    {
+        typename L::V acc0 = L::zero();
+        typename L::V acc1 = L::zero();
+        typename L::V acc2 = L::zero();
+        typename L::V acc3 = L::zero();
+        size_t i = 0;
+        for (; i + 4 * L::WIDTH <= n; i += 4 * L::WIDTH)
+        {
+            acc0 = L::add(acc0, L::load(a + i));
+            acc1 = L::add(acc1, L::load(a + i + L::WIDTH));
+            acc2 = L::add(acc2, L::load(a + i + 2 * L::WIDTH));
+            acc3 = L::add(acc3, L::load(a + i + 3 * L::WIDTH));
+        }
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            acc0 = L::add(acc0, L::load(a + i));
+        }
+        if (i < n)
+        {
+            acc1 = L::add(acc1, L::load(L::tail(n - i), a + i));
+        }
+        typename L::T lanes[L::WIDTH];
+        L::store(lanes, L::add(L::add(acc0, acc1), L::add(acc2, acc3)));
+        typename L::T total = 0;
+        for (size_t lane = 0; lane < L::WIDTH; lane++)
+        {
+            total += lanes[lane];
+        }
+        return total;
+    }
+
+    template<typename L>
+    EDGEMLP_AVX512 void axpy(const typename L::T alpha, const typename L::T* x, typename L::T* y, const size_t n)
+    {
+        const typename L::V a = L::set1(alpha);
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(y + i, L::fmadd(a, L::load(x + i), L::load(y + i)));
+        }
+        if (i < n)
+        {
+            const typename L::Mask m = L::tail(n - i);
+            L::store(y + i, m, L::fmadd(a, L::load(m, x + i), L::load(m, y + i)));
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX512 void relu(const typename L::T* a, typename L::T* out, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            const typename L::V x = L::load(a + i);
+            L::store(out + i, L::zeroWhereNotPositive(x, x));
+        }
+        if (i < n)
+        {
+            const typename L::Mask m = L::tail(n - i);
+            const typename L::V x = L::load(m, a + i);
+            L::store(out + i, m, L::zeroWhereNotPositive(x, x));
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX512 void reluBackward(const typename L::T* a, const typename L::T* grad, typename L::T* out, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, L::zeroWhereNotPositive(L::load(a + i), L::load(grad + i)));
+        }
+        if (i < n)
+        {
+            const typename L::Mask m = L::tail(n - i);
+            L::store(out + i, m, L::zeroWhereNotPositive(L::load(m, a + i), L::load(m, grad + i)));
+        }
+    }
+
+    // kernels::fastExp on a whole vector.
+    template<typename L>
+    EDGEMLP_AVX512 typename L::V expVector(typename L::V x)
+    {
+        using C = kernels::FastExp<typename L::T>;
+        x = L::max(L::set1(-C::CLAMP), L::min(L::set1(C::CLAMP), x));
+        const typename L::V kd = L::fmadd(x, L::set1(C::LOG2E), L::set1(C::SHIFT));
+        const typename L::V n = L::sub(kd, L::set1(C::SHIFT));
+        typename L::V r = L::fnmadd(n, L::set1(C::LN2_HI), x);
+        r = L::fnmadd(n, L::set1(C::LN2_LO), r);
+        typename L::V p = L::set1(C::COEFFICIENTS[C::DEGREE]);
+        for (int k = C::DEGREE - 1; k >= 0; k--)
+        {
+            p = L::fmadd(p, r, L::set1(C::COEFFICIENTS[k]));
+        }
+        return L::mul(p, L::exp2Shifted(kd));
+    }
+
+    template<typename L>
+    EDGEMLP_AVX512 typename L::V sigmoidVector(const typename L::V x)
+    {
+        const typename L::V one = L::set1(1);
+        return L::div(one, L::add(one, expVector<L>(L::sub(L::zero(), x))));
+    }
+
+    template<typename L>
+    EDGEMLP_AVX512 typename L::V tanhVector(const typename L::V x)
+    {
+        const typename L::V one = L::set1(1);
+        return L::sub(one, L::div(L::set1(2), L::add(one, expVector<L>(L::add(x, x)))));
+    }
+
+    template<typename L>
+    EDGEMLP_AVX512 void fastExp(const typename L::T* a, typename L::T* out, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, expVector<L>(L::load(a + i)));
+        }
+        if (i < n)
+        {
+            const typename L::Mask m = L::tail(n - i);
+            L::store(out + i, m, expVector<L>(L::load(m, a + i)));
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX512 void fastSigmoid(const typename L::T* a, typename L::T* out, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, sigmoidVector<L>(L::load(a + i)));
+        }
+        if (i < n)
+        {
+            const typename L::Mask m = L::tail(n - i);
+            L::store(out + i, m, sigmoidVector<L>(L::load(m, a + i)));
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX512 void fastTanh(const typename L::T* a, typename L::T* out, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            L::store(out + i, tanhVector<L>(L::load(a + i)));
+        }
+        if (i < n)
+        {
+            const typename L::Mask m = L::tail(n - i);
+            L::store(out + i, m, tanhVector<L>(L::load(m, a + i)));
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX512 void momentumVector(typename L::V& p, typename L::V& velocity, const typename L::V g,
+                                   const typename L::V lr, const typename L::V beta, const bool nesterov)
+    {
+        velocity = L::fmadd(beta, velocity, g);
+        p = L::fnmadd(lr, nesterov ? L::fmadd(beta, velocity, g) : velocity, p);
+    }
+
+    template<typename L>
+    EDGEMLP_AVX512 void momentumStep(typename L::T* p, typename L::T* velocity, const typename L::T* g,
+                                 const typename L::T lr, const typename L::T beta, const bool nesterov, const size_t n)
+    {
+        const typename L::V rate = L::set1(lr);
+        const typename L::V b = L::set1(beta);
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            typename L::V vel = L::load(velocity + i);
+            typename L::V param = L::load(p + i);
+            momentumVector<L>(param, vel, L::load(g + i), rate, b, nesterov);
+            L::store(velocity + i, vel);
+            L::store(p + i, param);
+        }
+        if (i < n)
+        {
+            const typename L::Mask mask = L::tail(n - i);
+            typename L::V vel = L::load(mask, velocity + i);
+            typename L::V param = L::load(mask, p + i);
+            momentumVector<L>(param, vel, L::load(mask, g + i), rate, b, nesterov);
+            L::store(velocity + i, mask, vel);
+            L::store(p + i, mask, param);
+        }
+    }
+
+    template<typename L>
+    EDGEMLP_AVX512 void adamVector(typename L::V& p, typename L::V& m, typename L::V& v, const typename L::V g,
+                               const kernels::AdamStep<typename L::T>& step)
+    {
+        m = L::fmadd(L::set1(step.beta1), m, L::mul(L::set1(1 - step.beta1), g));
+        v = L::fmadd(L::set1(step.beta2), v, L::mul(L::set1(1 - step.beta2), L::mul(g, g)));
+        p = L::fnmadd(L::set1(step.decay), p, p);
+        const typename L::V denominator = L::add(L::sqrt(L::mul(v, L::set1(step.secondMomentScale))), L::set1(step.epsilon));
+        p = L::fnmadd(L::set1(step.stepSize), L::div(m, denominator), p);
+    }
+
+    template<typename L>
+    EDGEMLP_AVX512 void adamStep(typename L::T* p, typename L::T* m, typename L::T* v, const typename L::T* g,
+                             const kernels::AdamStep<typename L::T>& step, const size_t n)
+    {
+        size_t i = 0;
+        for (; i + L::WIDTH <= n; i += L::WIDTH)
+        {
+            typename L::V param = L::load(p + i);
+            typename L::V first = L::load(m + i);
+            typename L::V second = L::load(v + i);
+            adamVector<L>(param, first, second, L::load(g + i), step);
+            L::store(m + i, first);
+            L::store(v + i, second);
+            L::store(p + i, param);
+        }
+        if (i < n)
+        {
+            const typename L::Mask mask = L::tail(n - i);
+            typename L::V param = L::load(mask, p + i);
+            typename L::V first = L::load(mask, m + i);
+            typename L::V second = L::load(mask, v + i);
+            adamVector<L>(param, first, second, L::load(mask, g + i), step);
+            L::store(m + i, mask, first);
+            L::store(v + i, mask, second);
+            L::store(p + i, mask, param);
+        }
+    }
+
+    template<typename L>
+    const kernels::ElementwiseKernels<typename L::T> AVX512_KERNELS{
+        kernels::Isa::Avx512,
+        add<L>,
+        sub<L>,
+        mul<L>,
+        scale<L>,
+        addScalar<L>,
+        sum<L>,
+        axpy<L>,
+        relu<L>,
+        reluBackward<L>,
+        fastExp<L>,
+        fastSigmoid<L>,
+        fastTanh<L>,
+        momentumStep<L>,
+        adamStep<L>,
+    };
+}
+
+namespace kernels
+{
+    template<typename T>
+    const ElementwiseKernels<T>& elementwiseAvx512()
+    {
+        return AVX512_KERNELS<std::conditional_t<std::is_same_v<T, double>, Lanes64, Lanes32>>;
+    }
+
+    template const ElementwiseKernels<double>& elementwiseAvx512<double>();
+    template const ElementwiseKernels<float>& elementwiseAvx512<float>();
+}
+
+#endif
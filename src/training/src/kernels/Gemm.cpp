@@ -0,0 +1,489 @@
+#include "../../include/kernels/Gemm.h"
+#include "../../include/ThreadPool.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    // Register tile computed by the micro-kernel: MR rows of A times NR columns of B.
+    constexpr int MR = 4;
+    constexpr int NR = 8;
+
+    // Cache blocking: a packed MC x KC block of A stays in L2 while a KC x NR
+    // sliver of B streams through L1; a KC x NC panel of B is shared by all A blocks.
+    constexpr int MC = 128;
+    constexpr int KC = 256;
+    constexpr int NC = 4096;
+
+    // Below this many multiply-adds packing costs more than it saves.
+    constexpr long SMALL_PRODUCT = 32L * 32L * 32L;
+
+    template<typename Acc>
+    void scaleC(const int m, const int n, const Acc beta, Acc* C, const int ldc)
+    {
+        for (int i = 0; i < m; i++)
+        {
+            Acc* c = C + static_cast<long>(i) * ldc;
+            if (beta == 0)
+            {
+                std::fill(c, c + n, Acc(0));
+            }
+            else if (beta != 1)
+            {
+                for (int j = 0; j < n; j++)
+                {
+                    c[j] *= beta;
+                }
+            }
+        }
+    }
+
+    // Element (i, p) of op(X) lives at X[i * rowStride + p * colStride].
+    template<typename T>
+    struct Operand
+    {
+        const T* data;
+        long rowStride;
+        long colStride;
+
+        Operand(const T* data, const int ld, const bool trans)
+            : data(data), rowStride(trans ? 1 : ld), colStride(trans ? ld : 1)
+        {
+        }
+
+        T operator()(const int i, const int p) const
+        {
+            return data[i * rowStride + p * colStride];
+        }
+
+        Operand offset(const int i, const int p) const
+        {
+            Operand o(*this);
+            o.data += i * rowStride + p * colStride;
+            return o;
+        }
+    };
+
+    // Row-major i-k-j loop over a handful of neurons; unit stride on C and, without
+    // transposes, on B as well.
+    template<typename T, typename Acc>
+    void gemmSmall(const int m, const int n, const int k, const Acc alpha, const Operand<T>& A,
+                   const Operand<T>& B, const Acc beta, Acc* C, const int ldc)
+    {
+        scaleC(m, n, beta, C, ldc);
+        for (int i = 0; i < m; i++)
+        {
+            Acc* c = C + static_cast<long>(i) * ldc;
+            for (int p = 0; p < k; p++)
+            {
+                const Acc aip = alpha * static_cast<Acc>(A(i, p));
+                for (int j = 0; j < n; j++)
+                {
+                    c[j] += aip * static_cast<Acc>(B(p, j));
+                }
+            }
+        }
+    }
+
+    // C = alpha * A * B^T and matrix-vector products: row i of A and column j of op(B)
+    // are both contiguous, so each element is a dot product. Four rows share every
+    // load of B and give four independent accumulation chains.
+    template<typename T, typename Acc>
+    void gemmDot(const int m, const int n, const int k, const Acc alpha, const Operand<T>& A,
+                 const Operand<T>& B, const Acc beta, Acc* C, const int ldc)
+    {
+        const auto store = [alpha, beta](Acc& c, const Acc sum)
+        {
+            c = beta == 0 ? alpha * sum : alpha * sum + beta * c;
+        };
+
+        int i = 0;
+        for (; i + 4 <= m; i += 4)
+        {
+            const T* a0 = A.data + i * A.rowStride;
+            const T* a1 = a0 + A.rowStride;
+            const T* a2 = a1 + A.rowStride;
+            const T* a3 = a2 + A.rowStride;
+            Acc* c = C + static_cast<long>(i) * ldc;
+            for (int j = 0; j < n; j++)
+            {
+                const T* b = B.data + j * B.colStride;
+                Acc s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+                for (int p = 0; p < k; p++)
+                {
+                    const Acc bp = b[p * B.rowStride];
+                    s0 += static_cast<Acc>(a0[p]) * bp;
+                    s1 += static_cast<Acc>(a1[p]) * bp;
+                    s2 += static_cast<Acc>(a2[p]) * bp;
+                    s3 += static_cast<Acc>(a3[p]) * bp;
+                }
+                store(c[j], s0);
+                store(c[j + ldc], s1);
+                store(c[j + 2L * ldc], s2);
+                store(c[j + 3L * ldc], s3);
+            }
+        }
+        for (; i < m; i++)
+        {
+            const T* a = A.data + i * A.rowStride;
+            Acc* c = C + static_cast<long>(i) * ldc;
+            for (int j = 0; j < n; j++)
+            {
+                const T* b = B.data + j * B.colStride;
+                Acc sum = 0;
+                for (int p = 0; p < k; p++)
+                {
+                    sum += static_cast<Acc>(a[p]) * static_cast<Acc>(b[p * B.rowStride]);
+                }
+                store(c[j], sum);
+            }
+        }
+    }
+
+    // C = alpha * A^T * B: stored row p of A is column p of A^T, so p runs outermost
+    // and every pass streams a row of A and a row of B with unit stride. A single
+    // output column becomes a sequence of axpy updates along the rows of A.
+    template<typename T, typename Acc>
+    void gemmTransA(const int m, const int n, const int k, const Acc alpha, const Operand<T>& A,
+                    const Operand<T>& B, const Acc beta, Acc* C, const int ldc)
+    {
+        scaleC(m, n, beta, C, ldc);
+        for (int p = 0; p < k; p++)
+        {
+            const T* a = A.data + p * A.colStride;
+            const T* b = B.data + p * B.rowStride;
+            if (n == 1 && ldc == 1)
+            {
+                const Acc bp = alpha * static_cast<Acc>(b[0]);
+                for (int i = 0; i < m; i++)
+                {
+                    C[i] += bp * static_cast<Acc>(a[i]);
+                }
+                continue;
+            }
+            for (int i = 0; i < m; i++)
+            {
+                const Acc aip = alpha * static_cast<Acc>(a[i]);
+                Acc* c = C + static_cast<long>(i) * ldc;
+                for (int j = 0; j < n; j++)
+                {
+                    c[j] += aip * static_cast<Acc>(b[j]);
+                }
+            }
+        }
+    }
+
+    // C = alpha * x * y^T + beta * C, the k == 1 case: one multiply per element of C.
+    template<typename T, typename Acc>
+    void gemmRank1(const int m, const int n, const Acc alpha, const Operand<T>& A,
+                   const Operand<T>& B, const Acc beta, Acc* C, const int ldc)
+    {
+        for (int i = 0; i < m; i++)
+        {
+            const Acc ai = alpha * static_cast<Acc>(A(i, 0));
+            Acc* c = C + static_cast<long>(i) * ldc;
+            if (B.colStride == 1)
+            {
+                const T* b = B.data;
+                if (beta == 0)
+                {
+                    for (int j = 0; j < n; j++)
+                    {
+                        c[j] = ai * static_cast<Acc>(b[j]);
+                    }
+                }
+                else
+                {
+                    for (int j = 0; j < n; j++)
+                    {
+                        c[j] = ai * static_cast<Acc>(b[j]) + beta * c[j];
+                    }
+                }
+                continue;
+            }
+            for (int j = 0; j < n; j++)
+            {
+                const Acc product = ai * static_cast<Acc>(B(0, j));
+                c[j] = beta == 0 ? product : product + beta * c[j];
+            }
+        }
+    }
+
+    // Products without operand reuse (matrix-vector, outer products) and small ones skip
+    // packing; the loop order is chosen so the innermost loop has unit stride.
+    template<typename T, typename Acc>
+    void gemmUnpacked(const bool transA, const bool transB, const int m, const int n, const int k,
+                      const Acc alpha, const Operand<T>& A, const Operand<T>& B, const Acc beta,
+                      Acc* C, const int ldc)
+    {
+        if (k == 1)
+        {
+            gemmRank1(m, n, alpha, A, B, beta, C, ldc);
+        }
+        else if (!transA && (transB || n == 1))
+        {
+            gemmDot(m, n, k, alpha, A, B, beta, C, ldc);
+        }
+        else if (transA && !transB)
+        {
+            gemmTransA(m, n, k, alpha, A, B, beta, C, ldc);
+        }
+        else
+        {
+            gemmSmall(m, n, k, alpha, A, B, beta, C, ldc);
+        }
+    }
+
+    // Packs an mc x kc block of op(A) into MR-row panels laid out so that the
+    // micro-kernel reads MR consecutive values per k step. Short panels are zero-padded.
+    template<typename T>
+    void packA(const int mc, const int kc, const Operand<T>& A, T* packed)
+    {
+        for (int ir = 0; ir < mc; ir += MR)
+        {
+            const int mr = std::min(MR, mc - ir);
+            for (int p = 0; p < kc; p++)
+            {
+                for (int i = 0; i < mr; i++)
+                {
+                    packed[i] = A(ir + i, p);
+                }
+                for (int i = mr; i < MR; i++)
+                {
+                    packed[i] = T(0);
+                }
+                packed += MR;
+            }
+        }
+    }
+
+    // Packs a kc x nc panel of op(B) into NR-column slivers, NR consecutive values per k step.
+    template<typename T>
+    void packB(const int kc, const int nc, const Operand<T>& B, T* packed)
+    {
+        for (int jr = 0; jr < nc; jr += NR)
+        {
+            const int nr = std::min(NR, nc - jr);
+            for (int p = 0; p < kc; p++)
+            {
+                for (int j = 0; j < nr; j++)
+                {
+                    packed[j] = B(p, jr + j);
+                }
+                for (int j = nr; j < NR; j++)
+                {
+                    packed[j] = T(0);
+                }
+                packed += NR;
+            }
+        }
+    }
+
+    // Computes an MR x NR tile of alpha * A * B in registers and merges it into C.
+    // Only the leading mr x nr part of the tile is written back.
+    template<typename T, typename Acc>
+    void microKernel(const int kc, const T* a, const T* b,
+                     const Acc alpha, const Acc beta, Acc* C, const int ldc,
+                     const int mr, const int nr)
+    {
+        Acc acc[MR][NR] = {};
+        for (int p = 0; p < kc; p++)
+        {
+            for (int i = 0; i < MR; i++)
+            {
+                const Acc ai = a[i];
+                for (int j = 0; j < NR; j++)
+                {
+                    acc[i][j] += ai * static_cast<Acc>(b[j]);
+                }
+            }
+            a += MR;
+            b += NR;
+        }
+
+        for (int i = 0; i < mr; i++)
+        {
+            Acc* c = C + static_cast<long>(i) * ldc;
+            if (beta == 0)
+            {
+                for (int j = 0; j < nr; j++)
+                {
+                    c[j] = alpha * acc[i][j];
+                }
+            }
+            else
+            {
+                for (int j = 0; j < nr; j++)
+                {
+                    c[j] = alpha * acc[i][j] + beta * c[j];
+                }
+            }
+        }
+    }
+
+    // Runs the epilogue on rows [i0, i0 + rows) and columns [j0, j0 + cols) of C.
+    template<typename Acc>
+    void finish(const kernels::GemmEpilogue<Acc>& epilogue, Acc* C, const int ldc,
+                const int i0, const int rows, const int j0, const int cols)
+    {
+        if (epilogue.bias == nullptr && epilogue.preActivation == nullptr && epilogue.apply == nullptr)
+        {
+            return;
+        }
+        // Whole rows of a tight C, e.g. a layer applied to one sample, form a single span
+        const bool contiguous = cols == ldc;
+        for (int i = i0; i < i0 + rows; i++)
+        {
+            Acc* c = C + static_cast<long>(i) * ldc + j0;
+            if (epilogue.bias != nullptr)
+            {
+                const Acc b = epilogue.bias[i * epilogue.biasStride];
+                for (int j = 0; j < cols; j++)
+                {
+                    c[j] += b;
+                }
+            }
+            if (epilogue.preActivation != nullptr)
+            {
+                std::copy(c, c + cols, epilogue.preActivation + static_cast<long>(i) * epilogue.ldPreActivation + j0);
+            }
+            if (epilogue.apply != nullptr && !contiguous)
+            {
+                epilogue.apply(epilogue.context, c, static_cast<size_t>(cols));
+            }
+        }
+        if (epilogue.apply != nullptr && contiguous)
+        {
+            epilogue.apply(epilogue.context, C + static_cast<long>(i0) * ldc, static_cast<size_t>(rows) * cols);
+        }
+    }
+
+    int roundUp(const int value, const int multiple)
+    {
+        return (value + multiple - 1) / multiple * multiple;
+    }
+
+    // Rows of C in one parallel task: enough for ParallelGrain::GEMM_FLOPS
+    // multiply-adds of rowWork each, in whole MR tiles.
+    int rowGrain(const long rowWork)
+    {
+        const long rows = static_cast<long>(ParallelGrain::GEMM_FLOPS) / std::max(rowWork, 1L);
+        return roundUp(static_cast<int>(std::clamp(rows, 1L, 1L << 20)), MR);
+    }
+}
+
+namespace kernels
+{
+    template<typename T, typename Acc>
+    void gemm(const bool transA, const bool transB, const int m, const int n, const int k,
+              const Acc alpha, const T* A, const int lda,
+              const T* B, const int ldb,
+              const Acc beta, Acc* C, const int ldc)
+    {
+        gemm(transA, transB, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc, GemmEpilogue<Acc>{});
+    }
+
+    template<typename T, typename Acc>
+    void gemm(const bool transA, const bool transB, const int m, const int n, const int k,
+              const Acc alpha, const T* A, const int lda,
+              const T* B, const int ldb,
+              const Acc beta, Acc* C, const int ldc, const GemmEpilogue<Acc>& epilogue)
+    {
+        const Operand<T> opA(A, lda, transA);
+        const Operand<T> opB(B, ldb, transB);
+
+        if (m <= 0 || n <= 0)
+        {
+            return;
+        }
+        if (k <= 0 || alpha == 0)
+        {
+            scaleC(m, n, beta, C, ldc);
+            finish(epilogue, C, ldc, 0, m, 0, n);
+            return;
+        }
+        // A vector operand is read once per element of C, so packing cannot pay off.
+        const bool vectorOperand = m == 1 || n == 1 || k == 1;
+        ThreadPool& pool = ThreadPool::global();
+        if (vectorOperand || static_cast<long>(m) * n * k <= SMALL_PRODUCT)
+        {
+            // Every unpacked path computes rows of C independently
+            pool.parallelFor(0, m, rowGrain(static_cast<long>(n) * k), [&](const size_t first, const size_t last)
+            {
+                const int i = static_cast<int>(first);
+                gemmUnpacked(transA, transB, static_cast<int>(last - first), n, k, alpha, opA.offset(i, 0), opB,
+                             beta, C + static_cast<long>(i) * ldc, ldc);
+                finish(epilogue, C, ldc, i, static_cast<int>(last - first), 0, n);
+            });
+            return;
+        }
+
+        // Packing buffers are reused across calls so steady-state products do not allocate.
+        thread_local std::vector<T> packedB;
+        packedB.resize(static_cast<size_t>(KC) * roundUp(std::min(n, NC), NR));
+
+        for (int jc = 0; jc < n; jc += NC)
+        {
+            const int nc = std::min(NC, n - jc);
+            for (int pc = 0; pc < k; pc += KC)
+            {
+                const int kc = std::min(KC, k - pc);
+                // The first k block applies the caller's beta, later ones accumulate.
+                const Acc betaBlock = pc == 0 ? beta : Acc(1);
+                const bool lastBlock = pc + kc == k;
+                packB(kc, nc, opB.offset(pc, jc), packedB.data());
+                const T* panelB = packedB.data();
+
+                // Row bands of C share the packed panel of B; each task packs its own A blocks
+                pool.parallelFor(0, m, rowGrain(static_cast<long>(nc) * kc), [&](const size_t first, const size_t last)
+                {
+                    thread_local std::vector<T> packedA;
+                    packedA.resize(static_cast<size_t>(KC) * MC);
+
+                    const int end = static_cast<int>(last);
+                    for (int ic = static_cast<int>(first); ic < end; ic += MC)
+                    {
+                        const int mc = std::min(MC, end - ic);
+                        packA(mc, kc, opA.offset(ic, pc), packedA.data());
+
+                        for (int jr = 0; jr < nc; jr += NR)
+                        {
+                            const int nr = std::min(NR, nc - jr);
+                            for (int ir = 0; ir < mc; ir += MR)
+                            {
+                                const int mr = std::min(MR, mc - ir);
+                                microKernel(kc, packedA.data() + static_cast<long>(ir) * kc,
+                                            panelB + static_cast<long>(jr) * kc,
+                                            alpha, betaBlock,
+                                            C + static_cast<long>(ic + ir) * ldc + jc + jr, ldc, mr, nr);
+                                if (lastBlock)
+                                {
+                                    // The tile is complete and still in L1
+                                    finish(epilogue, C, ldc, ic + ir, mr, jc + jr, nr);
+                                }
+                            }
+                        }
+                    }
+                });
+            }
+        }
+    }
+
+    template void gemm<double, double>(bool, bool, int, int, int, double, const double*, int,
+                                       const double*, int, double, double*, int);
+    template void gemm<float, float>(bool, bool, int, int, int, float, const float*, int,
+                                     const float*, int, float, float*, int);
+    template void gemm<int8_t, int32_t>(bool, bool, int, int, int, int32_t, const int8_t*, int,
+                                        const int8_t*, int, int32_t, int32_t*, int);
+    template void gemm<int32_t, int32_t>(bool, bool, int, int, int, int32_t, const int32_t*, int,
+                                         const int32_t*, int, int32_t, int32_t*, int);
+    template void gemm<double, double>(bool, bool, int, int, int, double, const double*, int,
+                                       const double*, int, double, double*, int, const GemmEpilogue<double>&);
+    template void gemm<float, float>(bool, bool, int, int, int, float, const float*, int,
+                                     const float*, int, float, float*, int, const GemmEpilogue<float>&);
+    template void gemm<int8_t, int32_t>(bool, bool, int, int, int, int32_t, const int8_t*, int,
+                                        const int8_t*, int, int32_t, int32_t*, int, const GemmEpilogue<int32_t>&);
+    template void gemm<int32_t, int32_t>(bool, bool, int, int, int, int32_t, const int32_t*, int,
+                                         const int32_t*, int, int32_t, int32_t*, int, const GemmEpilogue<int32_t>&);
+}
@@ -0,0 +1,162 @@
+#include "../../include/kernels/Reduction.h"
+#include "../../include/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+    // Leaf size of the pairwise tree; small enough that the lanes of the SIMD kernel
+    // each add only a few dozen values, large enough to amortize the recursion.
+    constexpr size_t PAIRWISE_BLOCK = 512;
+    // Subtrees evaluated in parallel by the reproducible mode: at most 2^MAX_DEPTH.
+    constexpr int MAX_PARALLEL_DEPTH = 6;
+
+    std::atomic<kernels::ReductionMode> defaultMode{kernels::ReductionMode::Fast};
+
+    // Logical elements [first, first + count) of a strided matrix, read row segment by row segment.
+    template<typename T>
+    struct Strided
+    {
+        const T* data;
+        size_t cols;
+        size_t ld;
+
+        kernels::accumulator_t<T> leaf(const kernels::ElementwiseKernels<T>& kernel, size_t first, size_t count) const
+        {
+            if (ld == cols)
+            {
+                return kernel.sum(data + first, count);
+            }
+            kernels::accumulator_t<T> total = 0;
+            while (count > 0)
+            {
+                const size_t row = first / cols;
+                const size_t col = first % cols;
+                const size_t segment = std::min(count, cols - col);
+                total += kernel.sum(data + row * ld + col, segment);
+                first += segment;
+                count -= segment;
+            }
+            return total;
+        }
+    };
+
+    // Left child size of a pairwise node: whole blocks, at least half a node's worth
+    // of blocks once the node is two blocks or more.
+    size_t leftHalf(const size_t count)
+    {
+        return count / 2 / PAIRWISE_BLOCK * PAIRWISE_BLOCK;
+    }
+
+    template<typename T>
+    kernels::accumulator_t<T> pairwise(const kernels::ElementwiseKernels<T>& kernel, const Strided<T>& input,
+                                       const size_t first, const size_t count)
+    {
+        if (count < 2 * PAIRWISE_BLOCK)
+        {
+            return input.leaf(kernel, first, count);
+        }
+        const size_t left = leftHalf(count);
+        return pairwise(kernel, input, first, left) + pairwise(kernel, input, first + left, count - left);
+    }
+
+    // Collects the nodes at the given depth of the pairwise tree, left to right.
+    void collectNodes(const size_t first, const size_t count, const int depth, size_t* firsts, size_t* counts,
+                      size_t& nodes)
+    {
+        if (depth == 0)
+        {
+            firsts[nodes] = first;
+            counts[nodes] = count;
+            nodes++;
+            return;
+        }
+        const size_t left = leftHalf(count);
+        collectNodes(first, left, depth - 1, firsts, counts, nodes);
+        collectNodes(first + left, count - left, depth - 1, firsts, counts, nodes);
+    }
+}
+
+namespace kernels
+{
+    ReductionMode reductionMode()
+    {
+        return defaultMode.load(std::memory_order_relaxed);
+    }
+
+    void setReductionMode(const ReductionMode mode)
+    {
+        defaultMode.store(mode, std::memory_order_relaxed);
+    }
+
+    template<typename T>
+    accumulator_t<T> pairwiseSum(const T* a, const size_t n)
+    {
+        return pairwise(elementwise<T>(), Strided<T>{a, n, n}, 0, n);
+    }
+
+    template<typename T>
+    accumulator_t<T> reduceSum(const T* a, const size_t rows, const size_t cols, const size_t ld,
+                               const ReductionMode mode)
+    {
+        using Acc = accumulator_t<T>;
+        const ElementwiseKernels<T>& kernel = elementwise<T>();
+        const size_t n = rows * cols;
+        // Packed input is read as a single row
+        const Strided<T> input = ld == cols || rows <= 1 ? Strided<T>{a, n, n} : Strided<T>{a, cols, ld};
+        ThreadPool& pool = ThreadPool::global();
+
+        if (mode == ReductionMode::Fast)
+        {
+            return pool.parallelReduce(0, n, std::max(ParallelGrain::REDUCTION, n / pool.size() + 1), Acc(0),
+                                       [&](const size_t first, const size_t last)
+            {
+                return pairwise(kernel, input, first, last - first);
+            }, [](const Acc x, const Acc y) { return x + y; });
+        }
+
+        // Deep enough for parallelism, shallow enough that every node above still splits
+        int depth = 0;
+        while (depth < MAX_PARALLEL_DEPTH && n >> (depth + 1) >= std::max(PAIRWISE_BLOCK, ParallelGrain::REDUCTION))
+        {
+            depth++;
+        }
+        if (depth == 0)
+        {
+            return pairwise(kernel, input, 0, n);
+        }
+
+        size_t firsts[1 << MAX_PARALLEL_DEPTH];
+        size_t counts[1 << MAX_PARALLEL_DEPTH];
+        Acc partial[1 << MAX_PARALLEL_DEPTH];
+        size_t nodes = 0;
+        collectNodes(0, n, depth, firsts, counts, nodes);
+        pool.parallelFor(0, nodes, 1, [&](const size_t begin, const size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                partial[i] = pairwise(kernel, input, firsts[i], counts[i]);
+            }
+        });
+        // Combine level by level, exactly as the serial recursion does
+        for (size_t width = nodes; width > 1; width /= 2)
+        {
+            for (size_t i = 0; i < width / 2; i++)
+            {
+                partial[i] = partial[2 * i] + partial[2 * i + 1];
+            }
+        }
+        return partial[0];
+    }
+
+    template accumulator_t<double> reduceSum<double>(const double*, size_t, size_t, size_t, ReductionMode);
+    template accumulator_t<float> reduceSum<float>(const float*, size_t, size_t, size_t, ReductionMode);
+    template accumulator_t<int8_t> reduceSum<int8_t>(const int8_t*, size_t, size_t, size_t, ReductionMode);
+    template accumulator_t<int32_t> reduceSum<int32_t>(const int32_t*, size_t, size_t, size_t, ReductionMode);
+
+    template accumulator_t<double> pairwiseSum<double>(const double*, size_t);
+    template accumulator_t<float> pairwiseSum<float>(const float*, size_t);
+    template accumulator_t<int8_t> pairwiseSum<int8_t>(const int8_t*, size_t);
+    template accumulator_t<int32_t> pairwiseSum<int32_t>(const int32_t*, size_t);
+}
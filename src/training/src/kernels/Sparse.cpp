@@ -0,0 +1,166 @@
+#include "../../include/kernels/Sparse.h"
+#include "../../include/ThreadPool.h"
+
+#include <algorithm>
+
+namespace
+{
+    template<typename Acc>
+    void scaleRow(const int n, const Acc beta, Acc* c)
+    {
+        if (beta == 0)
+        {
+            std::fill(c, c + n, Acc(0));
+        }
+        else if (beta != 1)
+        {
+            for (int j = 0; j < n; j++)
+            {
+                c[j] *= beta;
+            }
+        }
+    }
+
+    // Rows per parallel task when each row costs rowWork multiply-adds.
+    size_t rowGrain(const long rowWork)
+    {
+        return std::max<size_t>(1, ParallelGrain::GEMM_FLOPS / static_cast<size_t>(std::max(rowWork, 1L)));
+    }
+
+    // c[0 .. n) += a * op(B) row p.
+    template<typename T, typename Acc>
+    void addScaledRow(const bool transB, const int n, const int p, const Acc a, const T* B, const int ldb, Acc* c)
+    {
+        if (!transB)
+        {
+            const T* b = B + static_cast<long>(p) * ldb;
+            for (int j = 0; j < n; j++)
+            {
+                c[j] += a * static_cast<Acc>(b[j]);
+            }
+            return;
+        }
+        for (int j = 0; j < n; j++)
+        {
+            c[j] += a * static_cast<Acc>(B[static_cast<long>(j) * ldb + p]);
+        }
+    }
+}
+
+namespace kernels
+{
+    template<typename T, typename Acc>
+    void spmm(const bool transS, const bool transB, const int m, const int n, const int k,
+              const Acc alpha, const Csr<T> S, const T* B, const int ldb,
+              const Acc beta, Acc* C, const int ldc)
+    {
+        if (transS)
+        {
+            // Stored row p of S is column p of op(S): scatter it against row p of op(B)
+            for (int i = 0; i < m; i++)
+            {
+                scaleRow(n, beta, C + static_cast<long>(i) * ldc);
+            }
+            for (int p = 0; p < k; p++)
+            {
+                for (int q = S.pointers[p]; q < S.pointers[p + 1]; q++)
+                {
+                    Acc* c = C + static_cast<long>(S.indices[q]) * ldc;
+                    addScaledRow(transB, n, p, alpha * static_cast<Acc>(S.values[q]), B, ldb, c);
+                }
+            }
+            return;
+        }
+
+        const long rowWork = static_cast<long>(S.pointers[m]) / std::max(m, 1) * n;
+        ThreadPool::global().parallelFor(0, m, rowGrain(rowWork), [&](const size_t first, const size_t last)
+        {
+            for (int i = static_cast<int>(first); i < static_cast<int>(last); i++)
+            {
+                Acc* c = C + static_cast<long>(i) * ldc;
+                if (n == 1)
+                {
+                    // Sparse dot product gathering from the dense vector
+                    const long stride = transB ? 1 : ldb;
+                    Acc sum = 0;
+                    for (int q = S.pointers[i]; q < S.pointers[i + 1]; q++)
+                    {
+                        sum += static_cast<Acc>(S.values[q]) * static_cast<Acc>(B[S.indices[q] * stride]);
+                    }
+                    c[0] = beta == 0 ? alpha * sum : alpha * sum + beta * c[0];
+                    continue;
+                }
+                scaleRow(n, beta, c);
+                for (int q = S.pointers[i]; q < S.pointers[i + 1]; q++)
+                {
+                    addScaledRow(transB, n, S.indices[q], alpha * static_cast<Acc>(S.values[q]), B, ldb, c);
+                }
+            }
+        });
+    }
+
+    template<typename T, typename Acc>
+    void gemmSparse(const bool transA, const bool transS, const int m, const int n, const int k,
+                    const Acc alpha, const T* A, const int lda, const Csr<T> S,
+                    const Acc beta, Acc* C, const int ldc)
+    {
+        const long rowStride = transA ? 1 : lda;
+        const long colStride = transA ? lda : 1;
+        const long nonZeros = S.pointers[transS ? n : k];
+        const long rowWork = transS ? nonZeros : k + nonZeros;
+
+        ThreadPool::global().parallelFor(0, m, rowGrain(rowWork), [&](const size_t first, const size_t last)
+        {
+            for (int i = static_cast<int>(first); i < static_cast<int>(last); i++)
+            {
+                const T* a = A + i * rowStride;
+                Acc* c = C + static_cast<long>(i) * ldc;
+                if (transS)
+                {
+                    // Column j of op(S) is stored row j: a sparse dot product with row i of op(A)
+                    for (int j = 0; j < n; j++)
+                    {
+                        Acc sum = 0;
+                        for (int q = S.pointers[j]; q < S.pointers[j + 1]; q++)
+                        {
+                            sum += static_cast<Acc>(a[S.indices[q] * colStride]) * static_cast<Acc>(S.values[q]);
+                        }
+                        c[j] = beta == 0 ? alpha * sum : alpha * sum + beta * c[j];
+                    }
+                    continue;
+                }
+                scaleRow(n, beta, c);
+                for (int p = 0; p < k; p++)
+                {
+                    const Acc aip = alpha * static_cast<Acc>(a[p * colStride]);
+                    if (aip == 0)
+                    {
+                        continue;
+                    }
+                    for (int q = S.pointers[p]; q < S.pointers[p + 1]; q++)
+                    {
+                        c[S.indices[q]] += aip * static_cast<Acc>(S.values[q]);
+                    }
+                }
+            }
+        });
+    }
+
+    template void spmm<double, double>(bool, bool, int, int, int, double, Csr<double>, const double*, int,
+                                       double, double*, int);
+    template void spmm<float, float>(bool, bool, int, int, int, float, Csr<float>, const float*, int,
+                                     float, float*, int);
+    template void spmm<int8_t, int32_t>(bool, bool, int, int, int, int32_t, Csr<int8_t>, const int8_t*, int,
+                                        int32_t, int32_t*, int);
+    template void spmm<int32_t, int32_t>(bool, bool, int, int, int, int32_t, Csr<int32_t>, const int32_t*, int,
+                                         int32_t, int32_t*, int);
+
+    template void gemmSparse<double, double>(bool, bool, int, int, int, double, const double*, int, Csr<double>,
+                                             double, double*, int);
+    template void gemmSparse<float, float>(bool, bool, int, int, int, float, const float*, int, Csr<float>,
+                                           float, float*, int);
+    template void gemmSparse<int8_t, int32_t>(bool, bool, int, int, int, int32_t, const int8_t*, int, Csr<int8_t>,
+                                              int32_t, int32_t*, int);
+    template void gemmSparse<int32_t, int32_t>(bool, bool, int, int, int, int32_t, const int32_t*, int, Csr<int32_t>,
+                                               int32_t, int32_t*, int);
+}
@@ -0,0 +1,278 @@
+#include "../../include/loss_functions/CrossEntropy.h"
+#include "../../include/kernels/FastMath.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    template<typename T>
+    void checkShapes(const BasicMatrixView<T> output, const BasicMatrixView<T> target)
+    {
+        if (output.getRows() != target.getRows() || output.getCols() != target.getCols())
+        {
+            throw std::invalid_argument("Cross-entropy output and target must have the same shape");
+        }
+    }
+
+    template<typename T>
+    void checkResult(const BasicMatrixView<T> output, const BasicMatrix<T>& result)
+    {
+        if (result.getRows() != output.getRows() || result.getCols() != output.getCols())
+        {
+            throw std::invalid_argument("Cross-entropy gradient must have the shape of the output");
+        }
+    }
+
+    // Element (r, c) of a view is at r * row + c * col from its data, in either layout,
+    // so column-major views are read in place instead of gathered.
+    struct Strides
+    {
+        size_t row;
+        size_t col;
+    };
+
+    template<typename T>
+    Strides stridesOf(const BasicMatrixView<T> view)
+    {
+        const auto ld = static_cast<size_t>(view.getLeadingDimension());
+        return view.getLayout() == Layout::RowMajor ? Strides{ld, 1} : Strides{1, ld};
+    }
+
+    template<typename T>
+    bool rowMajor(const BasicMatrixView<T> view)
+    {
+        return view.getLayout() == Layout::RowMajor;
+    }
+
+    // Smallest probability the log is taken of, so a zero output costs a large finite loss.
+    template<typename T>
+    constexpr T PROBABILITY_FLOOR = std::numeric_limits<T>::min();
+}
+
+template<typename T>
+BasicCrossEntropy<T>::BasicCrossEntropy(const ActivationPrecision precision) : precision(precision)
+{
+}
+
+template<typename T>
+T BasicCrossEntropy<T>::calculate(const BasicMatrixView<T> output, const BasicMatrixView<T> target) const
+{
+    checkShapes(output, target);
+    if (output.getCols() == 0)
+    {
+        return T(0);
+    }
+    const Strides ps = stridesOf(output);
+    const Strides ys = stridesOf(target);
+    double total = 0;
+    for (int r = 0; r < output.getRows(); r++)
+    {
+        const T* p = output.getData() + r * ps.row;
+        const T* y = target.getData() + r * ys.row;
+        for (int c = 0; c < output.getCols(); c++)
+        {
+            if (y[c * ys.col] != 0)
+            {
+                total -= y[c * ys.col] * std::log(std::max(p[c * ps.col], PROBABILITY_FLOOR<T>));
+            }
+        }
+    }
+    return static_cast<T>(total / output.getCols());
+}
+
+template<typename T>
+BasicMatrix<T> BasicCrossEntropy<T>::derivative(const BasicMatrixView<T> output, const BasicMatrixView<T> target) const
+{
+    BasicMatrix<T> result(output.getRows(), output.getCols());
+    derivative(output, target, result);
+    return result;
+}
+
+template<typename T>
+void BasicCrossEntropy<T>::derivative(const BasicMatrixView<T> output, const BasicMatrixView<T> target, BasicMatrix<T>& result) const
+{
+    checkShapes(output, target);
+    checkResult(output, result);
+    const T scale = output.getCols() == 0 ? T(0) : T(-1) / output.getCols();
+    const Strides ps = stridesOf(output);
+    const Strides ys = stridesOf(target);
+    for (int r = 0; r < output.getRows(); r++)
+    {
+        const T* p = output.getData() + r * ps.row;
+        const T* y = target.getData() + r * ys.row;
+        T* out = result.getData() + static_cast<size_t>(r) * result.getLeadingDimension();
+        for (int c = 0; c < output.getCols(); c++)
+        {
+            out[c] = scale * y[c * ys.col] / std::max(p[c * ps.col], PROBABILITY_FLOOR<T>);
+        }
+    }
+}
+
+template<typename T>
+void BasicCrossEntropy<T>::derivativeAfterSoftmax(const BasicMatrixView<T> output, const BasicMatrixView<T> target, BasicMatrix<T>& result) const
+{
+    checkShapes(output, target);
+    checkResult(output, result);
+    if (output.getCols() == 0)
+    {
+        return;
+    }
+    const auto& k = kernels::elementwise<T>();
+    const T scale = T(1) / output.getCols();
+    const Strides ps = stridesOf(output);
+    const Strides ys = stridesOf(target);
+    for (int r = 0; r < output.getRows(); r++)
+    {
+        const T* p = output.getData() + r * ps.row;
+        const T* y = target.getData() + r * ys.row;
+        T* out = result.getData() + static_cast<size_t>(r) * result.getLeadingDimension();
+        if (rowMajor(output) && rowMajor(target))
+        {
+            k.sub(p, y, out, output.getCols());
+            k.scale(out, scale, out, output.getCols());
+            continue;
+        }
+        for (int c = 0; c < output.getCols(); c++)
+        {
+            out[c] = (p[c * ps.col] - y[c * ys.col]) * scale;
+        }
+    }
+}
+
+// One sample per column. Row-major inputs are walked row by row in three passes
+// over contiguous memory: column maxima, then exp(z - max) into the gradient while
+// accumulating the column sums and the target terms, then the normalisation fused
+// with "- target". Other layouts are walked one column at a time in place. The loss
+// of column c is log(sum_c) + max_c - sum_r target * z, since each target column
+// sums to one.
+template<typename T>
+T BasicCrossEntropy<T>::softmaxCrossEntropy(const BasicMatrixView<T> logits, const BasicMatrixView<T> target, BasicMatrix<T>* gradient) const
+{
+    checkShapes(logits, target);
+    BasicMatrix<T> local(0, 0);
+    if (gradient == nullptr)
+    {
+        local = BasicMatrix<T>(logits.getRows(), logits.getCols());
+        gradient = &local;
+    }
+    checkResult(logits, *gradient);
+    const int rows = logits.getRows();
+    const size_t cols = logits.getCols();
+    if (rows == 0 || cols == 0)
+    {
+        return T(0);
+    }
+
+    if (!rowMajor(logits) || !rowMajor(target))
+    {
+        return softmaxCrossEntropyByColumn(logits, target, *gradient);
+    }
+
+    const auto& k = kernels::elementwise<T>();
+    std::vector<T> maxima(cols), sums(cols, T(0)), targetDots(cols, T(0)), scratch(cols);
+    const auto rowOfGradient = [&](const int r)
+    {
+        return gradient->getData() + static_cast<size_t>(r) * gradient->getLeadingDimension();
+    };
+    const auto rowOfLogits = [&](const int r)
+    {
+        return logits.getData() + static_cast<size_t>(r) * logits.getLeadingDimension();
+    };
+    const auto rowOfTarget = [&](const int r)
+    {
+        return target.getData() + static_cast<size_t>(r) * target.getLeadingDimension();
+    };
+
+    std::copy_n(rowOfLogits(0), cols, maxima.data());
+    for (int r = 1; r < rows; r++)
+    {
+        const T* z = rowOfLogits(r);
+        for (size_t c = 0; c < cols; c++)
+        {
+            maxima[c] = std::max(maxima[c], z[c]);
+        }
+    }
+    for (int r = 0; r < rows; r++)
+    {
+        const T* z = rowOfLogits(r);
+        T* e = rowOfGradient(r);
+        k.mul(z, rowOfTarget(r), scratch.data(), cols);
+        k.add(targetDots.data(), scratch.data(), targetDots.data(), cols);
+        k.sub(z, maxima.data(), e, cols);
+        if (precision == ActivationPrecision::Fast)
+        {
+            k.fastExp(e, e, cols);
+        }
+        else
+        {
+            for (size_t c = 0; c < cols; c++)
+            {
+                e[c] = std::exp(e[c]);
+            }
+        }
+        k.add(sums.data(), e, sums.data(), cols);
+    }
+
+    double loss = 0;
+    const T scale = T(1) / cols;
+    for (size_t c = 0; c < cols; c++)
+    {
+        loss += std::log(sums[c]) + maxima[c] - targetDots[c];
+        // Reused as the factor turning exp(z - max) into softmax / samples
+        sums[c] = scale / sums[c];
+    }
+    for (int r = 0; r < rows; r++)
+    {
+        T* g = rowOfGradient(r);
+        k.mul(g, sums.data(), g, cols);
+        k.axpy(-scale, rowOfTarget(r), g, cols);
+    }
+    return static_cast<T>(loss / cols);
+}
+
+template<typename T>
+T BasicCrossEntropy<T>::softmaxCrossEntropyByColumn(const BasicMatrixView<T> logits, const BasicMatrixView<T> target,
+                                                    BasicMatrix<T>& gradient) const
+{
+    const Strides zs = stridesOf(logits);
+    const Strides ys = stridesOf(target);
+    const auto ldGradient = static_cast<size_t>(gradient.getLeadingDimension());
+    const int rows = logits.getRows();
+    const int cols = logits.getCols();
+    const T scale = T(1) / cols;
+    double loss = 0;
+    for (int c = 0; c < cols; c++)
+    {
+        const T* z = logits.getData() + c * zs.col;
+        const T* y = target.getData() + c * ys.col;
+        T* g = gradient.getData() + c;
+        T maximum = z[0];
+        for (int r = 1; r < rows; r++)
+        {
+            maximum = std::max(maximum, z[r * zs.row]);
+        }
+        T sum = 0;
+        T targetDot = 0;
+        for (int r = 0; r < rows; r++)
+        {
+            const T shifted = z[r * zs.row] - maximum;
+            const T e = precision == ActivationPrecision::Fast ? kernels::fastExp(shifted) : std::exp(shifted);
+            g[r * ldGradient] = e;
+            sum += e;
+            targetDot += z[r * zs.row] * y[r * ys.row];
+        }
+        loss += std::log(sum) + maximum - targetDot;
+        const T factor = scale / sum;
+        for (int r = 0; r < rows; r++)
+        {
+            g[r * ldGradient] = g[r * ldGradient] * factor - scale * y[r * ys.row];
+        }
+    }
+    return static_cast<T>(loss / cols);
+}
+
+template class BasicCrossEntropy<double>;
+template class BasicCrossEntropy<float>;
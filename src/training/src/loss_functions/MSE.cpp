@@ -1,24 +1,38 @@
 #include "../include/loss_functions/MSE.h"
 
-double MSE::calculate(const Matrix& output, const Matrix& target) const
+template<typename T>
+T BasicMSE<T>::calculate(const BasicMatrixView<T> output, const BasicMatrixView<T> target) const
 {
-    Matrix error = output - target;
-    const Matrix squared_error = error.hadamardProduct(error);
-    return squared_error.mean();
+    BasicMatrix<T> error = output - target;
+    const BasicMatrix<T> squared_error = error.hadamardProduct(error);
+    return static_cast<T>(squared_error.mean());
 }
 
-Matrix MSE::derivative(const Matrix& output, const Matrix& target) const
+template<typename T>
+BasicMatrix<T> BasicMSE<T>::derivative(const BasicMatrixView<T> output, const BasicMatrixView<T> target) const
 {
     const int n = output.getRows() * output.getCols();
 
     if (n==0)
     {
-        return Matrix(0, 0);
+        return BasicMatrix<T>(0, 0);
     }
 
-    Matrix error = output - target;
+    BasicMatrix<T> error = output - target;
 
-    const double scalar = 2.0/n;
+    const T scalar = static_cast<T>(2.0/n);
 
     return error * scalar;
 }
+
+template<typename T>
+void BasicMSE<T>::derivative(const BasicMatrixView<T> output, const BasicMatrixView<T> target, BasicMatrix<T>& result) const
+{
+    const int n = output.getRows() * output.getCols();
+    const T scalar = n == 0 ? T(0) : static_cast<T>(2.0/n);
+
+    result = (output - target) * scalar;
+}
+
+template class BasicMSE<double>;
+template class BasicMSE<float>;
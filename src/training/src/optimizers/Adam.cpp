@@ -0,0 +1,66 @@
+#include "../../include/optimizers/Adam.h"
+
+#include <cmath>
+
+#include "../../include/kernels/Elementwise.h"
+
+template<typename T>
+BasicAdam<T>::BasicAdam(const T beta1, const T beta2, const T epsilon)
+    : BasicAdam(beta1, beta2, epsilon, 0)
+{
+}
+
+// Until the first beginStep() updates are corrected as the first step's.
+template<typename T>
+BasicAdam<T>::BasicAdam(const T beta1, const T beta2, const T epsilon, const T weightDecay)
+    : beta1(beta1), beta2(beta2), epsilon(epsilon), weightDecay(weightDecay), step(0),
+      firstCorrection(1 - beta1), secondCorrection(1 - beta2)
+{
+}
+
+template<typename T>
+void BasicAdam<T>::beginStep()
+{
+    step++;
+    firstCorrection = static_cast<T>(1 - std::pow(static_cast<double>(beta1), static_cast<double>(step)));
+    secondCorrection = static_cast<T>(1 - std::pow(static_cast<double>(beta2), static_cast<double>(step)));
+}
+
+template<typename T>
+void BasicAdam<T>::reset()
+{
+    BasicOptimizer<T>::reset();
+    step = 0;
+    firstCorrection = 1 - beta1;
+    secondCorrection = 1 - beta2;
+}
+
+template<typename T>
+std::string BasicAdam<T>::name() const
+{
+    return "Adam";
+}
+
+template<typename T>
+long BasicAdam<T>::steps() const
+{
+    return step;
+}
+
+template<typename T>
+size_t BasicAdam<T>::stateCount() const
+{
+    return 2;
+}
+
+template<typename T>
+void BasicAdam<T>::updateSpan(T* parameters, T* const* state, const T* gradient, const size_t count,
+                              const T learningRate) const
+{
+    const kernels::AdamStep<T> adamStep{beta1, beta2, learningRate / firstCorrection, 1 / secondCorrection,
+                                        epsilon, learningRate * weightDecay};
+    kernels::elementwise<T>().adamStep(parameters, state[0], state[1], gradient, adamStep, count);
+}
+
+template class BasicAdam<double>;
+template class BasicAdam<float>;
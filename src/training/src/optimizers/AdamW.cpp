@@ -0,0 +1,16 @@
+#include "../../include/optimizers/AdamW.h"
+
+template<typename T>
+BasicAdamW<T>::BasicAdamW(const T weightDecay, const T beta1, const T beta2, const T epsilon)
+    : BasicAdam<T>(beta1, beta2, epsilon, weightDecay)
+{
+}
+
+template<typename T>
+std::string BasicAdamW<T>::name() const
+{
+    return "AdamW";
+}
+
+template class BasicAdamW<double>;
+template class BasicAdamW<float>;
@@ -0,0 +1,37 @@
+#include "../../include/optimizers/Momentum.h"
+
+#include "../../include/kernels/Elementwise.h"
+
+template<typename T>
+BasicMomentum<T>::BasicMomentum(const T momentum)
+    : BasicMomentum(momentum, false)
+{
+}
+
+template<typename T>
+BasicMomentum<T>::BasicMomentum(const T momentum, const bool nesterov)
+    : momentum(momentum), nesterov(nesterov)
+{
+}
+
+template<typename T>
+std::string BasicMomentum<T>::name() const
+{
+    return "Momentum";
+}
+
+template<typename T>
+size_t BasicMomentum<T>::stateCount() const
+{
+    return 1;
+}
+
+template<typename T>
+void BasicMomentum<T>::updateSpan(T* parameters, T* const* state, const T* gradient, const size_t count,
+                                  const T learningRate) const
+{
+    kernels::elementwise<T>().momentumStep(parameters, state[0], gradient, learningRate, momentum, nesterov, count);
+}
+
+template class BasicMomentum<double>;
+template class BasicMomentum<float>;
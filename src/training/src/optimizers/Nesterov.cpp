@@ -0,0 +1,16 @@
+#include "../../include/optimizers/Nesterov.h"
+
+template<typename T>
+BasicNesterov<T>::BasicNesterov(const T momentum)
+    : BasicMomentum<T>(momentum, true)
+{
+}
+
+template<typename T>
+std::string BasicNesterov<T>::name() const
+{
+    return "Nesterov";
+}
+
+template class BasicNesterov<double>;
+template class BasicNesterov<float>;
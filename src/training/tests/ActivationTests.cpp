@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "../include/Matrix.h"
+#include "../include/activation_functions/Linear.h"
+#include "../include/activation_functions/Relu.h"
+#include "../include/activation_functions/Sigmoid.h"
+#include "../include/activation_functions/Softmax.h"
+#include "../include/activation_functions/Tanh.h"
+
+namespace {
+    std::vector<std::shared_ptr<Activation>> allActivations() {
+        return {std::make_shared<Sigmoid>(), std::make_shared<Tanh>(), std::make_shared<Relu>(),
+                std::make_shared<Linear>(), std::make_shared<Softmax>()};
+    }
+}
+
+// The output-parameter variants reject an output or cached matrix of another shape
+TEST(ActivationTest, OutputParameterShapesAreChecked) {
+    const Matrix big(40, 40);
+    const Matrix small(2, 2);
+    for (const auto& activation : allActivations()) {
+        Matrix out(2, 2);
+        EXPECT_THROW(activation->forward(big, out), std::invalid_argument) << activation->name();
+        EXPECT_THROW(activation->backward(big, small, out), std::invalid_argument) << activation->name();
+        EXPECT_THROW(activation->backward(small, big, out), std::invalid_argument) << activation->name();
+        Matrix bigOut(40, 40);
+        EXPECT_THROW(activation->backward(small, small, bigOut), std::invalid_argument) << activation->name();
+        if (activation->derivativeUsesOutput()) {
+            EXPECT_THROW(activation->backwardFromOutput(big, small, out), std::invalid_argument) << activation->name();
+            EXPECT_THROW(activation->backwardFromOutput(small, big, out), std::invalid_argument) << activation->name();
+        }
+        EXPECT_NO_THROW(activation->forward(small, out)) << activation->name();
+    }
+}
+
+// The value-returning backward checks its operands as hadamardProduct used to, in
+// either order, instead of reading past the smaller one
+TEST(ActivationTest, ValueReturningBackwardChecksShapes) {
+    const Matrix big(40, 40);
+    const Matrix small(2, 2);
+    for (const auto& activation : allActivations()) {
+        EXPECT_THROW(activation->backward(big, small), std::invalid_argument) << activation->name();
+        EXPECT_THROW(activation->backward(small, big), std::invalid_argument) << activation->name();
+        EXPECT_NO_THROW(activation->backward(small, small)) << activation->name();
+    }
+}
+
+// The whole-buffer forward and backward of every element-wise activation agree with
+// its per-element methods on a padded batch, which has padding between rows, and
+// with an exact zero input, where ReLU has its kink
+template<typename A>
+class ElementwiseActivationTest : public ::testing::Test {
+};
+
+using ElementwiseActivations = ::testing::Types<Relu, Sigmoid, Tanh, Linear>;
+TYPED_TEST_SUITE(ElementwiseActivationTest, ElementwiseActivations);
+
+TYPED_TEST(ElementwiseActivationTest, BatchMatchesScalar) {
+    constexpr double EPS = 1e-12;
+    TypeParam activation;
+    Matrix input = Matrix::padded(37, 29);
+    Matrix gradient(37, 29);
+    input.randomize(-6.0, 6.0);
+    gradient.randomize(-1.0, 1.0);
+    input(0, 0) = 0.0;
+
+    const Matrix output = activation.forward(input);
+    Matrix localGradient = Matrix::padded(37, 29);
+    activation.backward(gradient, input, localGradient);
+    for (int i = 0; i < 37; ++i) {
+        for (int j = 0; j < 29; ++j) {
+            ASSERT_NEAR(output(i, j), activation.activate(input(i, j)), EPS);
+            ASSERT_NEAR(localGradient(i, j), gradient(i, j) * activation.derivative(input(i, j)), EPS);
+        }
+    }
+
+    // The derivative read from the cached output matches the one evaluated on the input
+    ASSERT_TRUE(activation.derivativeUsesOutput());
+    Matrix fromOutput(37, 29);
+    activation.backwardFromOutput(gradient, output, fromOutput);
+    for (int i = 0; i < 37; ++i) {
+        for (int j = 0; j < 29; ++j) {
+            ASSERT_NEAR(fromOutput(i, j), localGradient(i, j), EPS);
+        }
+    }
+
+    // The output may overwrite the activation input
+    activation.backward(gradient, input, input);
+    ASSERT_NEAR(input(36, 28), localGradient(36, 28), EPS);
+}
+
+namespace {
+    // Fast precision stays within its documented error (kernels/FastMath.h) of the
+    // exact path on a dense grid over [-30, 30], saturates like it beyond and passes
+    // NaN through. A is the double activation, AF the float one and reference the
+    // function in double precision, which the float path is measured against.
+    template<typename A, typename AF>
+    void expectFastMatchesExactOnGrid(double (*reference)(double), const double tolerance, const double toleranceF) {
+        const int n = 60001;
+        Matrix grid(1, n);
+        MatrixF gridF(1, n);
+        for (int i = 0; i < n; ++i) {
+            grid(0, i) = -30.0 + 60.0 * i / (n - 1);
+            gridF(0, i) = static_cast<float>(grid(0, i));
+        }
+
+        const Matrix exact = A().forward(grid);
+        const Matrix fast = A(ActivationPrecision::Fast).forward(grid);
+        const MatrixF fastF = AF(ActivationPrecision::Fast).forward(gridF);
+        double maxError = 0.0, maxErrorF = 0.0;
+        for (int i = 0; i < n; ++i) {
+            maxError = std::max(maxError, std::abs(fast(0, i) - exact(0, i)));
+            maxErrorF = std::max(maxErrorF, std::abs(fastF(0, i) - reference(gridF(0, i))));
+        }
+        EXPECT_LE(maxError, tolerance);
+        EXPECT_LE(maxErrorF, toleranceF);
+
+        Matrix edges(1, 3);
+        edges(0, 0) = 1000.0;
+        edges(0, 1) = -1000.0;
+        edges(0, 2) = std::nan("");
+        const Matrix fastEdges = A(ActivationPrecision::Fast).forward(edges);
+        const Matrix exactEdges = A().forward(edges);
+        EXPECT_NEAR(fastEdges(0, 0), exactEdges(0, 0), 1e-300);
+        EXPECT_NEAR(fastEdges(0, 1), exactEdges(0, 1), 1e-300);
+        EXPECT_TRUE(std::isnan(fastEdges(0, 2)));
+
+        // The backward pass evaluated on the input uses the same approximation
+        Matrix gradient(1, n);
+        gradient.randomize(-1.0, 1.0);
+        const Matrix fromInput = A(ActivationPrecision::Fast).backward(gradient, grid);
+        const Matrix fromExact = A().backward(gradient, grid);
+        for (int i = 0; i < n; i += 97) {
+            ASSERT_NEAR(fromInput(0, i), fromExact(0, i), 4 * tolerance);
+        }
+    }
+}
+
+TEST(ActivationTest, FastSigmoidMatchesExactOnGrid) {
+    expectFastMatchesExactOnGrid<Sigmoid, SigmoidF>([](const double x) { return 1.0 / (1.0 + std::exp(-x)); },
+                                                    3e-12, 2e-7);
+}
+
+TEST(ActivationTest, FastTanhMatchesExactOnGrid) {
+    expectFastMatchesExactOnGrid<Tanh, TanhF>([](const double x) { return std::tanh(x); }, 5e-12, 3e-7);
+}
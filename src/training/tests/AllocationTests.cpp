@@ -0,0 +1,280 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+#include "../include/Arena.h"
+#include "../include/MLP.h"
+#include "../include/activation_functions/Sigmoid.h"
+#include "../include/activation_functions/Relu.h"
+#include "../include/loss_functions/MSE.h"
+
+// Global operator new is replaced for the whole test binary so that tests can
+// count heap allocations made between two points.
+static std::atomic<long> allocationCount{0};
+
+void* operator new(const std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// Aligned forms are used by std::pmr resources and by arenas
+void* operator new(const std::size_t size, const std::align_val_t alignment)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t align = static_cast<std::size_t>(alignment);
+    const std::size_t rounded = (size + align - 1) / align * align;
+    if (void* p = std::aligned_alloc(align, rounded == 0 ? align : rounded))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](const std::size_t size, const std::align_val_t alignment)
+{
+    return operator new(size, alignment);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+static long allocationsDuring(const std::function<void()>& work)
+{
+    const long before = allocationCount.load();
+    work();
+    return allocationCount.load() - before;
+}
+
+// Once buffers are sized, a training step must not touch the heap
+TEST(AllocationTest, TrainingStepDoesNotAllocate)
+{
+    auto relu = std::make_shared<Relu>();
+    auto sigmoid = std::make_shared<Sigmoid>();
+    MLP mlp({16, 64, 32, 4}, {relu, relu, sigmoid}, 0.01, std::make_shared<MSE>());
+
+    Matrix input(16, 1);
+    input.randomize(-1.0, 1.0);
+    Matrix target(4, 1);
+    target.randomize(0.0, 1.0);
+
+    // Warm-up step sizes any lazily allocated scratch space
+    mlp.backpropagate(input, target);
+
+    const long allocations = allocationsDuring([&]
+    {
+        for (int i = 0; i < 10; i++)
+        {
+            mlp.backpropagate(input, target);
+        }
+    });
+
+    EXPECT_EQ(allocations, 0);
+}
+
+// Minibatches of a fixed size reuse the buffers sized by the first one
+TEST(AllocationTest, BatchTrainingStepDoesNotAllocate)
+{
+    auto relu = std::make_shared<Relu>();
+    auto sigmoid = std::make_shared<Sigmoid>();
+    MLP mlp({16, 64, 32, 4}, {relu, relu, sigmoid}, 0.01, std::make_shared<MSE>());
+
+    Matrix X(16, 64);
+    X.randomize(-1.0, 1.0);
+    Matrix y(4, 64);
+    y.randomize(0.0, 1.0);
+    mlp.backpropagate(X.colRange(0, 16), y.colRange(0, 16));
+
+    const long allocations = allocationsDuring([&]
+    {
+        for (int i = 0; i < X.getCols(); i += 16)
+        {
+            mlp.backpropagate(X.colRange(i, i + 16), y.colRange(i, i + 16));
+        }
+    });
+
+    EXPECT_EQ(allocations, 0);
+}
+
+// Epochs alternating full batches with a smaller final one reuse the buffers of both widths
+TEST(AllocationTest, BatchWidthChangesReuseLayerBuffers)
+{
+    auto relu = std::make_shared<Relu>();
+    auto sigmoid = std::make_shared<Sigmoid>();
+    MLP mlp({8, 32, 4}, {relu, sigmoid}, 0.01, std::make_shared<MSE>());
+
+    Matrix X(8, 50);
+    X.randomize(-1.0, 1.0);
+    Matrix y(4, 50);
+    y.randomize(0.0, 1.0);
+    // Batches of 16, 16, 16 and 2 size the buffers of both widths
+    mlp.train(X, y, 1, 0.01, 16);
+
+    EXPECT_EQ(allocationsDuring([&] { mlp.train(X, y, 3, 0.01, 16); }), 0);
+
+    // A new width allocates its buffers once
+    EXPECT_GT(allocationsDuring([&] { mlp.backpropagate(X.colRange(0, 5), y.colRange(0, 5)); }), 0);
+    EXPECT_EQ(allocationsDuring([&] { mlp.backpropagate(X.colRange(5, 10), y.colRange(5, 10)); }), 0);
+}
+
+// Shard workspaces persist across data-parallel steps like the network's own
+TEST(AllocationTest, DataParallelStepDoesNotAllocate)
+{
+    auto relu = std::make_shared<Relu>();
+    auto sigmoid = std::make_shared<Sigmoid>();
+    MLP mlp({16, 64, 32, 4}, {relu, relu, sigmoid}, 0.01, std::make_shared<MSE>());
+
+    Matrix X(16, 64);
+    X.randomize(-1.0, 1.0);
+    Matrix y(4, 64);
+    y.randomize(0.0, 1.0);
+    mlp.backpropagateParallel(X, y, 4);
+
+    EXPECT_EQ(allocationsDuring([&] { for (int i = 0; i < 5; i++) mlp.backpropagateParallel(X, y, 4); }), 0);
+}
+
+// Samples fed as columns of a dataset matrix are read through views, not copied
+TEST(AllocationTest, DatasetColumnsDoNotAllocate)
+{
+    auto sigmoid = std::make_shared<Sigmoid>();
+    MLP mlp({6, 12, 3}, {sigmoid, sigmoid}, 0.05, std::make_shared<MSE>());
+
+    Matrix X(6, 50);
+    X.randomize(-1.0, 1.0);
+    Matrix y(3, 50);
+    y.randomize(0.0, 1.0);
+    mlp.backpropagate(X.col(0), y.col(0));
+
+    const long allocations = allocationsDuring([&]
+    {
+        for (int i = 0; i < X.getCols(); i++)
+        {
+            mlp.backpropagate(X.col(i), y.col(i));
+        }
+    });
+
+    EXPECT_EQ(allocations, 0);
+}
+
+// After its first reset the arena serves a repeated step without the heap
+TEST(AllocationTest, ArenaSteadyStateDoesNotAllocate)
+{
+    Arena arena;
+    const auto step = [&]
+    {
+        {
+            Matrix a(32, 16, &arena);
+            Matrix b(16, 1, &arena);
+            arena.allocateArray<float>(300);
+        }
+        arena.reset();
+    };
+    step();
+
+    EXPECT_EQ(allocationsDuring([&] { for (int i = 0; i < 10; i++) step(); }), 0);
+}
+
+// Moving a matrix hands over its buffer
+TEST(AllocationTest, MoveDoesNotCopyBuffer)
+{
+    Matrix a(100, 100);
+    a(99, 99) = 7.0;
+    Matrix target(1, 1);
+
+    const long allocations = allocationsDuring([&]
+    {
+        Matrix b(std::move(a));
+        target = std::move(b);
+    });
+
+    EXPECT_EQ(allocations, 0);
+    EXPECT_EQ(target.getRows(), 100);
+    EXPECT_DOUBLE_EQ(target(99, 99), 7.0);
+}
+
+// Element-wise operators reuse the storage of expiring operands
+TEST(AllocationTest, ExpiringOperandsReuseStorage)
+{
+    Matrix a(20, 30), b(30, 10), c(20, 10);
+    a.randomize(-1.0, 1.0);
+    b.randomize(-1.0, 1.0);
+    c.randomize(-1.0, 1.0);
+    const Matrix product = a * b;
+
+    Matrix result(1, 1);
+    const long allocations = allocationsDuring([&]
+    {
+        // Only the product needs a new buffer
+        result = (a * b) * 2.0 + c - c.hadamardProduct(c);
+    });
+
+    EXPECT_EQ(allocations, 1);
+    EXPECT_NEAR(result(3, 4), product(3, 4) * 2.0 + c(3, 4) - c(3, 4) * c(3, 4), 1e-12);
+}
+
+// A forward pass writes into the layer buffers; only the returned output is a new matrix
+TEST(AllocationTest, ForwardPassCopiesOnlyTheOutput)
+{
+    auto relu = std::make_shared<Relu>();
+    MLP mlp({8, 32, 32, 32, 2}, {relu, relu, relu, relu}, 0.01, std::make_shared<MSE>());
+
+    Matrix input(8, 1);
+    input.randomize(-1.0, 1.0);
+    mlp.forward(input);
+
+    const long allocations = allocationsDuring([&]
+    {
+        const Matrix output = mlp.forward(input);
+        EXPECT_EQ(output.getRows(), 2);
+    });
+
+    EXPECT_EQ(allocations, 1);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "../include/Arena.h"
+#include "../include/Matrix.h"
+
+static bool isAligned(const void* p)
+{
+    return reinterpret_cast<std::uintptr_t>(p) % Arena::ALIGNMENT == 0;
+}
+
+// Test that allocations are aligned, disjoint and accounted for
+TEST(ArenaTest, AllocationsAreAlignedAndDisjoint)
+{
+    Arena arena(1024);
+    EXPECT_EQ(arena.capacity(), 1024u);
+
+    double* a = arena.allocateArray<double>(3);
+    double* b = arena.allocateArray<double>(5);
+    ASSERT_TRUE(isAligned(a));
+    ASSERT_TRUE(isAligned(b));
+    EXPECT_GE(reinterpret_cast<std::uintptr_t>(b), reinterpret_cast<std::uintptr_t>(a + 3));
+    EXPECT_EQ(arena.used(), Arena::ALIGNMENT + 5 * sizeof(double));
+
+    // Larger alignments than a cache line are honoured as well
+    void* wide = arena.allocate(8, 256);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(wide) % 256, 0u);
+}
+
+// Test that reset hands the same memory out again
+TEST(ArenaTest, ResetReusesBuffer)
+{
+    Arena arena(4096);
+    float* first = arena.allocateArray<float>(100);
+    arena.allocateArray<float>(100);
+    arena.reset();
+
+    EXPECT_EQ(arena.used(), 0u);
+    EXPECT_EQ(arena.allocateArray<float>(100), first);
+}
+
+// Test that a step larger than the buffer is served and the buffer grows to fit it
+TEST(ArenaTest, OverflowGrowsOnReset)
+{
+    Arena arena;
+    EXPECT_EQ(arena.capacity(), 0u);
+
+    int32_t* a = arena.allocateArray<int32_t>(1000);
+    int32_t* b = arena.allocateArray<int32_t>(3000);
+    a[999] = 1;
+    b[2999] = 2;
+    ASSERT_TRUE(isAligned(a));
+    ASSERT_TRUE(isAligned(b));
+
+    arena.reset();
+    EXPECT_GE(arena.capacity(), 4000 * sizeof(int32_t));
+
+    // The same sequence now fits in the single buffer
+    const size_t capacity = arena.capacity();
+    arena.allocateArray<int32_t>(1000);
+    arena.allocateArray<int32_t>(3000);
+    EXPECT_LE(arena.used(), capacity);
+    arena.reset();
+    EXPECT_EQ(arena.capacity(), capacity);
+}
+
+// Test that matrices can borrow arena storage and copies own theirs
+TEST(ArenaTest, MatrixBorrowsStorage)
+{
+    Arena arena(1 << 16);
+    Matrix m(8, 8, &arena);
+    m(7, 7) = 3.0;
+    EXPECT_DOUBLE_EQ(m(0, 0), 0.0);
+    EXPECT_TRUE(isAligned(m.getData()));
+    EXPECT_GE(arena.used(), 64 * sizeof(double));
+
+    const Matrix copy = m;
+    EXPECT_NE(copy.getData(), m.getData());
+    EXPECT_DOUBLE_EQ(copy(7, 7), 3.0);
+
+    const size_t used = arena.used();
+    Matrix other(8, 8, &arena);
+    other = m * 2.0;
+    EXPECT_DOUBLE_EQ(other(7, 7), 6.0);
+    EXPECT_EQ(arena.used(), used + 64 * sizeof(double));
+}
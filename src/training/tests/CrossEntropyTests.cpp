@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+
+#include "../include/Matrix.h"
+#include "../include/activation_functions/Softmax.h"
+#include "../include/loss_functions/CrossEntropy.h"
+
+namespace {
+    // One-hot targets, the class of column c being c % rows.
+    Matrix oneHot(const int rows, const int cols) {
+        Matrix y(rows, cols);
+        for (int c = 0; c < cols; c++) y(c % rows, c) = 1.0;
+        return y;
+    }
+}
+
+TEST(CrossEntropyTest, ForwardPass) {
+    CrossEntropy ce;
+    Matrix p(2, 2), y(2, 2);
+    p(0, 0) = 0.25; p(0, 1) = 0.5;
+    p(1, 0) = 0.75; p(1, 1) = 0.5;
+    y(0, 0) = 0.0;  y(0, 1) = 1.0;
+    y(1, 0) = 1.0;  y(1, 1) = 0.0;
+    // Mean of -log(0.75) and -log(0.5) over the two samples
+    EXPECT_NEAR(ce.calculate(p, y), -(std::log(0.75) + std::log(0.5)) / 2, 1e-15);
+
+    const Matrix d = ce.derivative(p, y);
+    EXPECT_NEAR(d(0, 0), 0.0, 1e-15);
+    EXPECT_NEAR(d(1, 0), -1 / 0.75 / 2, 1e-15);
+    EXPECT_NEAR(d(0, 1), -1 / 0.5 / 2, 1e-15);
+
+    // A zero probability costs a large finite loss instead of infinity
+    p(1, 0) = 0.0;
+    EXPECT_TRUE(std::isfinite(ce.calculate(p, y)));
+    EXPECT_THROW(ce.calculate(p, Matrix(3, 2)), std::invalid_argument);
+}
+
+// The fused loss and gradient agree with softmax followed by cross-entropy and its Jacobian
+TEST(CrossEntropyTest, FusedMatchesSeparatePasses) {
+    Softmax softmax;
+    CrossEntropy ce;
+    Matrix z(6, 9);
+    z.randomize(-4.0, 4.0);
+    const Matrix y = oneHot(6, 9);
+
+    Matrix fused(6, 9);
+    const double loss = ce.softmaxCrossEntropy(z, y, &fused);
+    EXPECT_NEAR(ce.softmaxCrossEntropy(z, y), loss, 1e-15);
+
+    const Matrix p = softmax.forward(z);
+    EXPECT_NEAR(loss, ce.calculate(p, y), 1e-12);
+    Matrix chained(6, 9);
+    softmax.backwardFromOutput(ce.derivative(p, y), p, chained);
+    Matrix collapsed(6, 9);
+    ce.derivativeAfterSoftmax(p, y, collapsed);
+    for (int r = 0; r < 6; r++) {
+        for (int c = 0; c < 9; c++) {
+            EXPECT_NEAR(fused(r, c), (p(r, c) - y(r, c)) / 9, 1e-15);
+            EXPECT_NEAR(chained(r, c), fused(r, c), 1e-12);
+            EXPECT_NEAR(collapsed(r, c), fused(r, c), 1e-15);
+        }
+    }
+}
+
+// Log-sum-exp keeps the fused loss exact where exp(z) would overflow
+TEST(CrossEntropyTest, FusedStableForLargeLogits) {
+    CrossEntropy ce;
+    Matrix z(3, 1), y(3, 1);
+    z(0, 0) = 1000; z(1, 0) = 1001; z(2, 0) = 999;
+    y(2, 0) = 1.0;
+    Matrix gradient(3, 1);
+    const double loss = ce.softmaxCrossEntropy(z, y, &gradient);
+    EXPECT_NEAR(loss, 2 + std::log(1 + std::exp(-1.0) + std::exp(-2.0)), 1e-12);
+    const double sum = 1 + std::exp(-1.0) + std::exp(-2.0);
+    EXPECT_NEAR(gradient(1, 0), 1 / sum, 1e-15);
+    EXPECT_NEAR(gradient(2, 0), std::exp(-2.0) / sum - 1, 1e-15);
+}
+
+// A minibatch gives the mean of the per-sample losses, and per-sample gradients over the batch size
+TEST(CrossEntropyTest, FusedBatchMatchesPerSample) {
+    for (ActivationPrecision precision : {ActivationPrecision::Exact, ActivationPrecision::Fast}) {
+        CrossEntropyF ce(precision);
+        MatrixF z(10, 7);
+        z.randomize(-30.0f, 30.0f);
+        MatrixF y(10, 7);
+        for (int c = 0; c < 7; c++) y((3 * c) % 10, c) = 1.0f;
+
+        MatrixF batchGradient(10, 7);
+        const float batchLoss = ce.softmaxCrossEntropy(z, y, &batchGradient);
+        float total = 0;
+        for (int c = 0; c < 7; c++) {
+            MatrixF gradient(10, 1);
+            total += ce.softmaxCrossEntropy(z.view().col(c), y.view().col(c), &gradient);
+            for (int r = 0; r < 10; r++) EXPECT_NEAR(batchGradient(r, c), gradient(r, 0) / 7, 1e-7f);
+        }
+        EXPECT_NEAR(batchLoss, total / 7, 1e-4f * std::abs(batchLoss) + 1e-6f);
+    }
+}
+
+// Column-major views, e.g. batches of a column-major dataset, are read in place and
+// give the results of their row-major copies
+TEST(CrossEntropyTest, ColumnMajorViewsMatchRowMajor) {
+    Matrix z(6, 9);
+    z.randomize(-5.0, 5.0);
+    const Matrix y = oneHot(6, 9);
+    const Matrix zT = z.view().transposed();
+    const Matrix yT = y.view().transposed();
+    const MatrixView zColumns = zT.view().transposed();
+    const MatrixView yColumns = yT.view().transposed();
+    ASSERT_EQ(zColumns.getLayout(), Layout::ColumnMajor);
+
+    for (ActivationPrecision precision : {ActivationPrecision::Exact, ActivationPrecision::Fast}) {
+        CrossEntropy ce(precision);
+        const Matrix p = Softmax().forward(z);
+        const Matrix pT = p.view().transposed();
+        const MatrixView pColumns = pT.view().transposed();
+        EXPECT_NEAR(ce.calculate(pColumns, yColumns), ce.calculate(p, y), 1e-12);
+
+        Matrix expected(6, 9), actual(6, 9);
+        ce.derivative(p, y, expected);
+        ce.derivative(pColumns, y, actual);
+        for (int r = 0; r < 6; r++)
+            for (int c = 0; c < 9; c++) EXPECT_NEAR(actual(r, c), expected(r, c), 1e-12);
+
+        ce.derivativeAfterSoftmax(p, y, expected);
+        ce.derivativeAfterSoftmax(p, yColumns, actual);
+        for (int r = 0; r < 6; r++)
+            for (int c = 0; c < 9; c++) EXPECT_NEAR(actual(r, c), expected(r, c), 1e-15);
+
+        const double loss = ce.softmaxCrossEntropy(z, y, &expected);
+        EXPECT_NEAR(ce.softmaxCrossEntropy(zColumns, yColumns, &actual), loss, 1e-12);
+        for (int r = 0; r < 6; r++)
+            for (int c = 0; c < 9; c++) EXPECT_NEAR(actual(r, c), expected(r, c), 1e-12);
+        EXPECT_NEAR(ce.softmaxCrossEntropy(z, yColumns, &actual), loss, 1e-12);
+    }
+}
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "../include/kernels/Elementwise.h"
+
+using kernels::Isa;
+
+// Quarter steps are exact in both float and double
+template<typename T>
+static std::vector<T> makeInput(const size_t n, const double offset)
+{
+    std::vector<T> v(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        v[i] = static_cast<T>(offset + static_cast<double>((i * 37) % 101) * 0.25 - 12.5);
+    }
+    return v;
+}
+
+// The scalar path is always available and is the selected one when nothing better is
+TEST(ElementwiseTest, ScalarAlwaysAvailable)
+{
+    ASSERT_NE(kernels::elementwiseFor<double>(Isa::Scalar), nullptr);
+    EXPECT_EQ(kernels::elementwiseFor<double>(Isa::Scalar)->isa, Isa::Scalar);
+    EXPECT_NE(kernels::elementwiseFor<double>(kernels::elementwise<double>().isa), nullptr);
+    EXPECT_NE(kernels::elementwiseFor<float>(kernels::elementwise<float>().isa), nullptr);
+}
+
+// Integer element types have no SIMD table and always run the scalar path
+TEST(ElementwiseTest, IntegerTypesUseScalarPath)
+{
+    EXPECT_EQ(kernels::elementwise<int8_t>().isa, Isa::Scalar);
+    EXPECT_EQ(kernels::elementwise<int32_t>().isa, Isa::Scalar);
+    EXPECT_EQ(kernels::elementwiseFor<int32_t>(Isa::Avx2), nullptr);
+    EXPECT_EQ(kernels::elementwise<int8_t>().fastSigmoid, nullptr);
+    EXPECT_EQ(kernels::elementwise<int32_t>().adamStep, nullptr);
+
+    // int8 sums widen to int32 instead of wrapping
+    const std::vector<int8_t> a(300, 100);
+    EXPECT_EQ(kernels::elementwise<int8_t>().sum(a.data(), a.size()), 30000);
+}
+
+// Every SIMD variant supported by this CPU must agree with the scalar reference,
+// including lengths that leave a partial vector at the end
+template<typename T>
+static void expectSimdMatchesScalar(const double sumTolerance, const double axpyTolerance)
+{
+    const auto& ref = *kernels::elementwiseFor<T>(Isa::Scalar);
+    for (const Isa isa : {Isa::Avx2, Isa::Avx512})
+    {
+        const auto* simd = kernels::elementwiseFor<T>(isa);
+        if (simd == nullptr)
+        {
+            continue;
+        }
+        for (const size_t n : {0, 1, 3, 4, 7, 8, 15, 16, 17, 33, 1000})
+        {
+            const auto a = makeInput<T>(n, 0.0);
+            const auto b = makeInput<T>(n, 3.0);
+            std::vector<T> expected(n), actual(n);
+
+            ref.add(a.data(), b.data(), expected.data(), n);
+            simd->add(a.data(), b.data(), actual.data(), n);
+            EXPECT_EQ(expected, actual) << kernels::isaName(isa) << " add n=" << n;
+
+            ref.sub(a.data(), b.data(), expected.data(), n);
+            simd->sub(a.data(), b.data(), actual.data(), n);
+            EXPECT_EQ(expected, actual) << kernels::isaName(isa) << " sub n=" << n;
+
+            ref.mul(a.data(), b.data(), expected.data(), n);
+            simd->mul(a.data(), b.data(), actual.data(), n);
+            EXPECT_EQ(expected, actual) << kernels::isaName(isa) << " mul n=" << n;
+
+            ref.scale(a.data(), -1.5, expected.data(), n);
+            simd->scale(a.data(), -1.5, actual.data(), n);
+            EXPECT_EQ(expected, actual) << kernels::isaName(isa) << " scale n=" << n;
+
+            ref.addScalar(a.data(), 2.25, expected.data(), n);
+            simd->addScalar(a.data(), 2.25, actual.data(), n);
+            EXPECT_EQ(expected, actual) << kernels::isaName(isa) << " addScalar n=" << n;
+
+            ref.relu(a.data(), expected.data(), n);
+            simd->relu(a.data(), actual.data(), n);
+            EXPECT_EQ(expected, actual) << kernels::isaName(isa) << " relu n=" << n;
+
+            ref.reluBackward(a.data(), b.data(), expected.data(), n);
+            simd->reluBackward(a.data(), b.data(), actual.data(), n);
+            EXPECT_EQ(expected, actual) << kernels::isaName(isa) << " reluBackward n=" << n;
+
+            // Same approximation; only the FMA rounding differs
+            std::vector<T> expectedTanh(n), actualTanh(n);
+            ref.fastSigmoid(a.data(), expected.data(), n);
+            simd->fastSigmoid(a.data(), actual.data(), n);
+            ref.fastTanh(a.data(), expectedTanh.data(), n);
+            simd->fastTanh(a.data(), actualTanh.data(), n);
+            for (size_t i = 0; i < n; i++)
+            {
+                EXPECT_NEAR(expected[i], actual[i], axpyTolerance) << kernels::isaName(isa) << " fastSigmoid n=" << n;
+                EXPECT_NEAR(expectedTanh[i], actualTanh[i], axpyTolerance) << kernels::isaName(isa) << " fastTanh n=" << n;
+            }
+
+            EXPECT_NEAR(ref.sum(a.data(), n), simd->sum(a.data(), n), sumTolerance) << kernels::isaName(isa) << " sum n=" << n;
+
+            // FMA rounds once, so axpy may differ from the scalar path in the last bit
+            expected = b;
+            actual = b;
+            ref.axpy(0.75, a.data(), expected.data(), n);
+            simd->axpy(0.75, a.data(), actual.data(), n);
+            for (size_t i = 0; i < n; i++)
+            {
+                EXPECT_NEAR(expected[i], actual[i], axpyTolerance) << kernels::isaName(isa) << " axpy n=" << n;
+            }
+        }
+    }
+}
+
+TEST(ElementwiseTest, SimdMatchesScalarReference)
+{
+    expectSimdMatchesScalar<double>(1e-9, 1e-12);
+}
+
+TEST(ElementwiseTest, FloatSimdMatchesScalarReference)
+{
+    expectSimdMatchesScalar<float>(1e-2, 1e-5);
+}
+
+// The fused optimizer steps update parameters and state in place; a few steps in a
+// row check that the state written by one step is what the next one reads
+template<typename T>
+static void expectOptimizerStepsMatchScalar(const double tolerance)
+{
+    const auto& ref = *kernels::elementwiseFor<T>(Isa::Scalar);
+    const kernels::AdamStep<T> adam{T(0.9), T(0.999), T(0.01), T(2), T(1e-8), T(0.001)};
+    for (const Isa isa : {Isa::Avx2, Isa::Avx512})
+    {
+        const auto* simd = kernels::elementwiseFor<T>(isa);
+        if (simd == nullptr)
+        {
+            continue;
+        }
+        for (const size_t n : {0, 1, 7, 8, 17, 33, 1000})
+        {
+            const auto g = makeInput<T>(n, 0.0);
+            for (const bool nesterov : {false, true})
+            {
+                auto expected = makeInput<T>(n, 1.0);
+                auto actual = expected;
+                std::vector<T> expectedVelocity(n), actualVelocity(n);
+                for (int step = 0; step < 3; step++)
+                {
+                    ref.momentumStep(expected.data(), expectedVelocity.data(), g.data(), T(0.1), T(0.9), nesterov, n);
+                    simd->momentumStep(actual.data(), actualVelocity.data(), g.data(), T(0.1), T(0.9), nesterov, n);
+                }
+                for (size_t i = 0; i < n; i++)
+                {
+                    EXPECT_NEAR(expected[i], actual[i], tolerance * (1 + std::abs(expected[i])))
+                        << kernels::isaName(isa) << " momentumStep n=" << n << " nesterov=" << nesterov;
+                    EXPECT_NEAR(expectedVelocity[i], actualVelocity[i], tolerance * (1 + std::abs(expectedVelocity[i])))
+                        << kernels::isaName(isa) << " momentumStep velocity n=" << n;
+                }
+            }
+
+            auto expected = makeInput<T>(n, 1.0);
+            auto actual = expected;
+            std::vector<T> expectedM(n), actualM(n), expectedV(n), actualV(n);
+            for (int step = 0; step < 3; step++)
+            {
+                ref.adamStep(expected.data(), expectedM.data(), expectedV.data(), g.data(), adam, n);
+                simd->adamStep(actual.data(), actualM.data(), actualV.data(), g.data(), adam, n);
+            }
+            for (size_t i = 0; i < n; i++)
+            {
+                EXPECT_NEAR(expected[i], actual[i], tolerance * (1 + std::abs(expected[i])))
+                    << kernels::isaName(isa) << " adamStep n=" << n;
+                EXPECT_NEAR(expectedM[i], actualM[i], tolerance * (1 + std::abs(expectedM[i])))
+                    << kernels::isaName(isa) << " adamStep m n=" << n;
+                EXPECT_NEAR(expectedV[i], actualV[i], tolerance * (1 + std::abs(expectedV[i])))
+                    << kernels::isaName(isa) << " adamStep v n=" << n;
+            }
+        }
+    }
+}
+
+TEST(ElementwiseTest, OptimizerStepsMatchScalarReference)
+{
+    expectOptimizerStepsMatchScalar<double>(1e-12);
+    expectOptimizerStepsMatchScalar<float>(1e-5);
+}
+
+// Writing the result over one of the inputs is allowed
+TEST(ElementwiseTest, OutputMayAliasInput)
+{
+    auto a = makeInput<double>(19, 0.0);
+    const auto b = makeInput<double>(19, 1.0);
+    const auto original = a;
+
+    kernels::elementwise<double>().add(a.data(), b.data(), a.data(), a.size());
+
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        EXPECT_DOUBLE_EQ(a[i], original[i] + b[i]);
+    }
+}
@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "../include/Matrix.h"
+#include "../include/kernels/Gemm.h"
+
+// Reference product used to validate the blocked kernel
+static Matrix naiveMultiply(const Matrix& a, const Matrix& b)
+{
+    Matrix result(a.getRows(), b.getCols());
+    for (int i = 0; i < a.getRows(); i++)
+    {
+        for (int j = 0; j < b.getCols(); j++)
+        {
+            double sum = 0;
+            for (int k = 0; k < a.getCols(); k++)
+            {
+                sum += a(i, k) * b(k, j);
+            }
+            result(i, j) = sum;
+        }
+    }
+    return result;
+}
+
+// Shapes that are not multiples of the register tile or cache blocks
+TEST(GemmTest, MatchesNaiveOnOddShapes)
+{
+    const int shapes[][3] = {{1, 1, 1}, {3, 5, 7}, {37, 300, 19}, {129, 65, 257}, {260, 9, 513}};
+    for (const auto& s : shapes)
+    {
+        Matrix a(s[0], s[1]);
+        Matrix b(s[1], s[2]);
+        a.randomize(-1.0, 1.0);
+        b.randomize(-1.0, 1.0);
+
+        const Matrix expected = naiveMultiply(a, b);
+        const Matrix result = a * b;
+
+        ASSERT_EQ(result.getRows(), s[0]);
+        ASSERT_EQ(result.getCols(), s[2]);
+        for (int i = 0; i < s[0]; i++)
+        {
+            for (int j = 0; j < s[2]; j++)
+            {
+                ASSERT_NEAR(result(i, j), expected(i, j), 1e-10) << s[0] << "x" << s[1] << "x" << s[2];
+            }
+        }
+    }
+}
+
+// C = alpha * A * B + beta * C on sub-blocks of larger buffers
+TEST(GemmTest, AlphaBetaAndLeadingDimensions)
+{
+    const int m = 70, n = 90, k = 80;
+    const int lda = k + 3, ldb = n + 5, ldc = n + 7;
+    std::vector<double> A(m * lda), B(k * ldb), C(m * ldc), expected(m * ldc);
+    for (size_t i = 0; i < A.size(); i++) A[i] = static_cast<double>(i % 13) - 6.0;
+    for (size_t i = 0; i < B.size(); i++) B[i] = static_cast<double>(i % 7) - 3.0;
+    for (size_t i = 0; i < C.size(); i++) C[i] = expected[i] = static_cast<double>(i % 5);
+
+    const double alpha = 0.5, beta = -2.0;
+    for (int i = 0; i < m; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            double sum = 0;
+            for (int p = 0; p < k; p++)
+            {
+                sum += A[i * lda + p] * B[p * ldb + j];
+            }
+            expected[i * ldc + j] = alpha * sum + beta * expected[i * ldc + j];
+        }
+    }
+
+    kernels::gemm(false, false, m, n, k, alpha, A.data(), lda, B.data(), ldb, beta, C.data(), ldc);
+
+    for (size_t i = 0; i < C.size(); i++)
+    {
+        ASSERT_DOUBLE_EQ(C[i], expected[i]) << "index " << i;
+    }
+}
+
+// beta == 0 must overwrite C without reading it, even if it holds NaN
+TEST(GemmTest, BetaZeroIgnoresExistingValues)
+{
+    const int n = 40;
+    std::vector<double> A(n * n, 1.0), B(n * n, 2.0), C(n * n, std::numeric_limits<double>::quiet_NaN());
+
+    kernels::gemm(false, false, n, n, n, 1.0, A.data(), n, B.data(), n, 0.0, C.data(), n);
+
+    for (const double c : C)
+    {
+        ASSERT_DOUBLE_EQ(c, 2.0 * n);
+    }
+}
+
+// Transposed operands through the packed path
+TEST(GemmTest, TransposedOperandsMatchNaive)
+{
+    Matrix a(150, 90), b(120, 150);
+    a.randomize(-1.0, 1.0);
+    b.randomize(-1.0, 1.0);
+
+    // a^T * b^T is 90 x 120
+    Matrix c(90, 120);
+    gemm(c, a, b, 1.0, 0.0, true, true);
+    const Matrix expected = naiveMultiply(a.transpose(), b.transpose());
+    for (int i = 0; i < 90; i++)
+    {
+        for (int j = 0; j < 120; j++)
+        {
+            ASSERT_NEAR(c(i, j), expected(i, j), 1e-10);
+        }
+    }
+}
+
+// Matrix-vector, outer-product and small shapes take the unpacked paths, whose loop
+// order depends on which operand is transposed
+TEST(GemmTest, UnpackedPathsMatchNaiveForEveryTranspose)
+{
+    const int shapes[][3] = {{300, 1, 200}, {1, 300, 200}, {200, 250, 1}, {7, 5, 3}, {9, 1, 9}, {6, 11, 2}};
+    for (const auto& s : shapes)
+    {
+        const int m = s[0], n = s[1], k = s[2];
+        for (const bool transA : {false, true})
+        {
+            for (const bool transB : {false, true})
+            {
+                // Stored shapes of A and B, with padded leading dimensions
+                const int lda = (transA ? m : k) + 2;
+                const int ldb = (transB ? k : n) + 3;
+                const int ldc = n + 1;
+                std::vector<double> A((transA ? k : m) * lda), B((transB ? n : k) * ldb);
+                std::vector<double> C(m * ldc), expected(m * ldc);
+                for (size_t i = 0; i < A.size(); i++) A[i] = static_cast<double>(i % 11) - 5.0;
+                for (size_t i = 0; i < B.size(); i++) B[i] = static_cast<double>(i % 7) - 3.0;
+                for (size_t i = 0; i < C.size(); i++) C[i] = expected[i] = static_cast<double>(i % 5);
+
+                const double alpha = 1.5, beta = 0.5;
+                for (int i = 0; i < m; i++)
+                {
+                    for (int j = 0; j < n; j++)
+                    {
+                        double sum = 0;
+                        for (int p = 0; p < k; p++)
+                        {
+                            const double a = transA ? A[p * lda + i] : A[i * lda + p];
+                            const double b = transB ? B[j * ldb + p] : B[p * ldb + j];
+                            sum += a * b;
+                        }
+                        expected[i * ldc + j] = alpha * sum + beta * expected[i * ldc + j];
+                    }
+                }
+
+                kernels::gemm(transA, transB, m, n, k, alpha, A.data(), lda, B.data(), ldb, beta, C.data(), ldc);
+
+                for (size_t i = 0; i < C.size(); i++)
+                {
+                    ASSERT_DOUBLE_EQ(C[i], expected[i])
+                        << m << "x" << n << "x" << k << " transA=" << transA << " transB=" << transB;
+                }
+            }
+        }
+    }
+}
+
+// The epilogue sees every element exactly once, after its last k block, on every path
+TEST(GemmTest, EpilogueMatchesSeparatePasses)
+{
+    // Unpacked, vector, packed with several k blocks, and k == 0
+    const int shapes[][3] = {{5, 7, 3}, {300, 40, 1}, {129, 300, 65}, {6, 0, 9}};
+    for (const auto& s : shapes)
+    {
+        Matrix a(s[0], s[1]), b(s[1], s[2]), bias = Matrix::padded(s[0], 1);
+        a.randomize(-1.0, 1.0);
+        b.randomize(-1.0, 1.0);
+        bias.randomize(-1.0, 1.0);
+
+        Matrix result = Matrix::padded(s[0], s[2]);
+        Matrix z(s[0], s[2]);
+        kernels::GemmEpilogue<double> epilogue;
+        epilogue.bias = bias.getData();
+        epilogue.biasStride = bias.getLeadingDimension();
+        epilogue.preActivation = z.getData();
+        epilogue.ldPreActivation = z.getLeadingDimension();
+        epilogue.apply = [](void*, double* values, const size_t count)
+        {
+            for (size_t j = 0; j < count; j++)
+            {
+                values[j] = 2.0 * values[j] + 1.0;
+            }
+        };
+        gemm(result, a.view(), b.view(), epilogue);
+
+        const Matrix product = s[1] > 0 ? naiveMultiply(a, b) : Matrix(s[0], s[2]);
+        for (int i = 0; i < s[0]; i++)
+        {
+            for (int j = 0; j < s[2]; j++)
+            {
+                const double expectedZ = product(i, j) + bias(i, 0);
+                ASSERT_NEAR(z(i, j), expectedZ, 1e-10) << s[0] << "x" << s[1] << "x" << s[2];
+                ASSERT_NEAR(result(i, j), 2.0 * expectedZ + 1.0, 1e-10) << s[0] << "x" << s[1] << "x" << s[2];
+            }
+        }
+    }
+}
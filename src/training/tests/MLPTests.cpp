@@ -3,6 +3,10 @@
 #include "../include/Matrix.h"
 #include "../include/activation_functions/Sigmoid.h"
 #include "../include/activation_functions/Linear.h"
+#include "../include/activation_functions/Relu.h"
+#include "../include/activation_functions/Tanh.h"
+#include "../include/activation_functions/Softmax.h"
+#include "../include/loss_functions/CrossEntropy.h"
 #include <vector>
 #include <cmath>
 #include <memory>
@@ -212,6 +216,31 @@ TEST(MLPTest, XORConvergenceTest) {
     }
 }
 
+// Test that a single-precision network learns XOR as well
+TEST(MLPTest, FloatXORConvergenceTest) {
+    auto sigmoid = std::make_shared<SigmoidF>();
+    MLPF mlp({2, 4, 1}, {sigmoid, sigmoid}, 0.5f, std::make_shared<MSEF>());
+
+    std::vector<MatrixF> inputs(4, MatrixF(2, 1));
+    std::vector<MatrixF> targets(4, MatrixF(1, 1));
+    for (int i = 0; i < 4; ++i) {
+        inputs[i](0, 0) = static_cast<float>(i / 2);
+        inputs[i](1, 0) = static_cast<float>(i % 2);
+        targets[i](0, 0) = static_cast<float>((i / 2) ^ (i % 2));
+    }
+
+    for (int epoch = 0; epoch < 5000; ++epoch) {
+        for (int i = 0; i < 4; ++i) {
+            mlp.backpropagate(inputs[i], targets[i]);
+        }
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        MatrixF output = mlp.forward(inputs[i]);
+        EXPECT_NEAR(output(0, 0), targets[i](0, 0), 0.1f);
+    }
+}
+
 // Verify loss decreases over time
 TEST(MLPTest, LossDecreasesOverTime) {
     std::vector<int> layer_sizes = {2, 2, 1};
@@ -261,3 +290,356 @@ TEST(MLPTest, OverfitSmallDataset) {
     // Overfit should result in high precision
     EXPECT_NEAR(out(0, 0), 0.888, 0.01);
 }
+
+// Sigmoid that only offers the derivative on its input, as a custom activation would
+struct InputDerivativeSigmoid : Sigmoid {
+    bool derivativeUsesOutput() const override { return false; }
+};
+
+// Backprop from the cached outputs takes the same steps as backprop re-evaluating z
+TEST(MLPTest, BackwardFromCachedOutputMatchesInputDerivative) {
+    auto mse = std::make_shared<MSE>();
+    auto sigmoid = std::make_shared<Sigmoid>();
+    auto inputSigmoid = std::make_shared<InputDerivativeSigmoid>();
+    MLP fromOutput({3, 6, 2}, {sigmoid, sigmoid}, 0.3, mse);
+    MLP fromInput({3, 6, 2}, {inputSigmoid, inputSigmoid}, 0.3, mse);
+    fromInput.weights = fromOutput.weights;
+    fromInput.biases = fromOutput.biases;
+
+    Matrix X(3, 8), y(2, 8);
+    X.randomize(-1.0, 1.0);
+    y.randomize(0.0, 1.0);
+    fromOutput.train(X, y, 5, 0.3);
+    fromInput.train(X, y, 5, 0.3);
+
+    for (size_t l = 0; l < 2; l++) {
+        for (int i = 0; i < fromOutput.weights[l].getRows(); i++) {
+            for (int j = 0; j < fromOutput.weights[l].getCols(); j++) {
+                EXPECT_NEAR(fromOutput.weights[l](i, j), fromInput.weights[l](i, j), 1e-12);
+            }
+        }
+    }
+
+    Matrix gradient(2, 1);
+    EXPECT_THROW(inputSigmoid->backwardFromOutput(gradient, gradient, gradient), std::logic_error);
+}
+
+// Cross-entropy behind a plain Loss, so backprop has to go through the softmax Jacobian
+struct UnfusedCrossEntropy : Loss {
+    CrossEntropy ce;
+    double calculate(MatrixView output, MatrixView target) const override { return ce.calculate(output, target); }
+    Matrix derivative(MatrixView output, MatrixView target) const override { return ce.derivative(output, target); }
+};
+
+// Softmax with cross-entropy uses the collapsed p - y delta, which takes the same steps as the chain rule
+TEST(MLPTest, SoftmaxCrossEntropyMatchesChainRule) {
+    auto sigmoid = std::make_shared<Sigmoid>();
+    auto softmax = std::make_shared<Softmax>();
+    MLP fused({4, 8, 3}, {sigmoid, softmax}, 0.2, std::make_shared<CrossEntropy>());
+    MLP chained({4, 8, 3}, {sigmoid, softmax}, 0.2, std::make_shared<UnfusedCrossEntropy>());
+    chained.weights = fused.weights;
+    chained.biases = fused.biases;
+
+    Matrix X(4, 12), y(3, 12);
+    X.randomize(-1.0, 1.0);
+    for (int c = 0; c < 12; c++) y(c % 3, c) = 1.0;
+    fused.train(X, y, 5, 0.2);
+    chained.train(X, y, 5, 0.2);
+
+    for (size_t l = 0; l < 2; l++) {
+        for (int i = 0; i < fused.weights[l].getRows(); i++) {
+            for (int j = 0; j < fused.weights[l].getCols(); j++) {
+                EXPECT_NEAR(fused.weights[l](i, j), chained.weights[l](i, j), 1e-12);
+            }
+        }
+    }
+}
+
+// A softmax classifier separates three clusters
+TEST(MLPTest, SoftmaxClassifierConverges) {
+    MLP mlp({2, 8, 3}, {std::make_shared<Sigmoid>(), std::make_shared<Softmax>()}, 0.5, std::make_shared<CrossEntropy>());
+    const double centers[3][2] = {{-1, -1}, {1, -1}, {0, 1}};
+    Matrix X(2, 30), y(3, 30);
+    X.randomize(-0.3, 0.3);
+    for (int c = 0; c < 30; c++) {
+        X(0, c) += centers[c % 3][0];
+        X(1, c) += centers[c % 3][1];
+        y(c % 3, c) = 1.0;
+    }
+    mlp.train(X, y, 300, 0.5);
+
+    for (int c = 0; c < 30; c++) {
+        const Matrix p = mlp.forward(X.col(c));
+        int predicted = 0;
+        for (int r = 1; r < 3; r++) {
+            if (p(r, 0) > p(predicted, 0)) predicted = r;
+        }
+        EXPECT_EQ(predicted, c % 3);
+    }
+}
+
+// A batch forward pass gives every column the output of that sample on its own
+TEST(MLPTest, BatchForwardMatchesPerSample) {
+    auto sigmoid = std::make_shared<Sigmoid>();
+    MLP mlp({5, 9, 3}, {sigmoid, sigmoid}, 0.1, std::make_shared<MSE>());
+    mlp.biases[0].randomize(-1.0, 1.0);
+    Matrix X(5, 7);
+    X.randomize(-1.0, 1.0);
+
+    const Matrix batch = mlp.forward(X);
+    ASSERT_EQ(batch.getRows(), 3);
+    ASSERT_EQ(batch.getCols(), 7);
+    for (int c = 0; c < 7; c++) {
+        const Matrix single = mlp.forward(X.col(c));
+        for (int r = 0; r < 3; r++) {
+            EXPECT_NEAR(batch(r, c), single(r, 0), 1e-12);
+        }
+    }
+}
+
+// One batch step moves the weights by the mean of the per-sample steps
+TEST(MLPTest, BatchStepAveragesPerSampleGradients) {
+    auto tanh = std::make_shared<Tanh>();
+    auto sigmoid = std::make_shared<Sigmoid>();
+    const std::vector<int> sizes = {4, 6, 2};
+    MLP batched(sizes, {tanh, sigmoid}, 0.1, std::make_shared<MSE>());
+    batched.biases[0].randomize(-0.5, 0.5);
+    const std::vector<Matrix> weights = batched.weights;
+    const std::vector<Matrix> biases = batched.biases;
+
+    Matrix X(4, 5), y(2, 5);
+    X.randomize(-1.0, 1.0);
+    y.randomize(0.0, 1.0);
+    batched.backpropagate(X, y);
+
+    std::vector<Matrix> meanWeights, meanBiases;
+    for (size_t l = 0; l < 2; l++) {
+        meanWeights.emplace_back(weights[l].getRows(), weights[l].getCols());
+        meanBiases.emplace_back(biases[l].getRows(), 1);
+    }
+    for (int c = 0; c < 5; c++) {
+        MLP single(sizes, {tanh, sigmoid}, 0.1, std::make_shared<MSE>());
+        single.weights = weights;
+        single.biases = biases;
+        single.backpropagate(X.col(c), y.col(c));
+        for (size_t l = 0; l < 2; l++) {
+            meanWeights[l].axpy(0.2, single.weights[l]);
+            meanBiases[l].axpy(0.2, single.biases[l]);
+        }
+    }
+
+    for (size_t l = 0; l < 2; l++) {
+        for (int i = 0; i < weights[l].getRows(); i++) {
+            for (int j = 0; j < weights[l].getCols(); j++) {
+                EXPECT_NEAR(batched.weights[l](i, j), meanWeights[l](i, j), 1e-12);
+            }
+            EXPECT_NEAR(batched.biases[l](i, 0), meanBiases[l](i, 0), 1e-12);
+        }
+    }
+}
+
+// Minibatch training learns XOR, including a final batch smaller than the rest
+TEST(MLPTest, MinibatchXORConvergence) {
+    auto sigmoid = std::make_shared<Sigmoid>();
+    auto tanh = std::make_shared<Tanh>();
+    MLP mlp({2, 8, 1}, {tanh, sigmoid}, 1.0, std::make_shared<MSE>());
+    Matrix X(2, 12), y(1, 12);
+    for (int c = 0; c < 12; c++) {
+        X(0, c) = (c >> 1) & 1;
+        X(1, c) = c & 1;
+        y(0, c) = X(0, c) != X(1, c) ? 1.0 : 0.0;
+    }
+    mlp.train(X, y, 3000, 2.0, 5);
+
+    const Matrix output = mlp.forward(X);
+    for (int c = 0; c < 12; c++) {
+        EXPECT_NEAR(output(0, c), y(0, c), 0.15);
+    }
+    EXPECT_THROW(mlp.train(X, y, 1, 0.1, 0), std::invalid_argument);
+}
+
+// A copy is an independent snapshot, and a moved-from network refuses to run
+TEST(MLPTest, CopyIsIndependentSnapshot) {
+    auto tanh = std::make_shared<Tanh>();
+    auto sigmoid = std::make_shared<Sigmoid>();
+    MLP mlp({2, 4, 1}, {tanh, sigmoid}, 0.5, std::make_shared<MSE>());
+    Matrix X(2, 4), y(1, 4);
+    for (int c = 0; c < 4; c++) {
+        X(0, c) = c >> 1;
+        X(1, c) = c & 1;
+        y(0, c) = X(0, c) != X(1, c) ? 1.0 : 0.0;
+    }
+    mlp.backpropagate(X, y);
+
+    MLP snapshot = mlp;
+    const Matrix before = snapshot.forward(X);
+    mlp.backpropagate(X, y);
+    const Matrix trained = mlp.forward(X);
+    const Matrix after = snapshot.forward(X);
+    for (int c = 0; c < 4; c++) {
+        EXPECT_DOUBLE_EQ(before(0, c), after(0, c));
+        EXPECT_NE(trained(0, c), after(0, c));
+    }
+
+    // Copy assignment brings the snapshot level with the trained network
+    snapshot = mlp;
+    const Matrix assigned = snapshot.forward(X);
+    for (int c = 0; c < 4; c++) {
+        EXPECT_DOUBLE_EQ(assigned(0, c), trained(0, c));
+    }
+
+    MLP moved = std::move(mlp);
+    EXPECT_NO_THROW(moved.forward(X));
+    EXPECT_THROW(mlp.forward(X), std::logic_error);
+    EXPECT_THROW(mlp.backpropagate(X, y), std::logic_error);
+    EXPECT_THROW(MLP().forward(X), std::logic_error);
+}
+
+namespace {
+    void expectSameParameters(const MLP& a, const MLP& b, const double tolerance) {
+        for (size_t l = 0; l < a.weights.size(); l++) {
+            for (int i = 0; i < a.weights[l].getRows(); i++) {
+                for (int j = 0; j < a.weights[l].getCols(); j++) {
+                    EXPECT_NEAR(a.weights[l](i, j), b.weights[l](i, j), tolerance);
+                }
+                EXPECT_NEAR(a.biases[l](i, 0), b.biases[l](i, 0), tolerance);
+            }
+        }
+    }
+}
+
+// Splitting a batch into shards and reducing their gradients takes the same step as the whole batch
+TEST(MLPTest, DataParallelStepMatchesSerialStep) {
+    auto relu = std::make_shared<Relu>();
+    auto softmax = std::make_shared<Softmax>();
+    Matrix X(6, 10), y(3, 10);
+    X.randomize(-1.0, 1.0);
+    for (int c = 0; c < 10; c++) y(c % 3, c) = 1.0;
+
+    // Uneven shards, and more shards than samples
+    for (int shards : {1, 3, 4, 16}) {
+        MLP serial({6, 12, 8, 3}, {relu, relu, softmax}, 0.1, std::make_shared<CrossEntropy>());
+        MLP parallel({6, 12, 8, 3}, {relu, relu, softmax}, 0.1, std::make_shared<CrossEntropy>());
+        parallel.weights = serial.weights;
+        for (int step = 0; step < 3; step++) {
+            serial.backpropagate(X, y);
+            parallel.backpropagateParallel(X, y, shards);
+        }
+        expectSameParameters(serial, parallel, 1e-12);
+    }
+
+    MLP mlp({6, 12, 8, 3}, {relu, relu, softmax}, 0.1, std::make_shared<CrossEntropy>());
+    EXPECT_THROW(mlp.backpropagateParallel(X, y, 0), std::invalid_argument);
+    EXPECT_THROW(mlp.backpropagateParallel(X, Matrix(3, 9), 2), std::invalid_argument);
+}
+
+// Shard boundaries and the reduction order do not depend on the number of threads
+TEST(MLPTest, DataParallelTrainingIsIndependentOfThreadCount) {
+    auto tanh = std::make_shared<Tanh>();
+    auto sigmoid = std::make_shared<Sigmoid>();
+    Matrix X(5, 40), y(2, 40);
+    X.randomize(-1.0, 1.0);
+    y.randomize(0.0, 1.0);
+
+    MLP reference({5, 16, 2}, {tanh, sigmoid}, 0.2, std::make_shared<MSE>());
+    const std::vector<Matrix> weights = reference.weights;
+    std::vector<MLP> trained;
+    for (int threads : {1, 3}) {
+        ThreadPool::setGlobalThreadCount(threads);
+        MLP mlp({5, 16, 2}, {tanh, sigmoid}, 0.2, std::make_shared<MSE>());
+        mlp.weights = weights;
+        mlp.train(X, y, 4, 0.2, 16, 5);
+        trained.push_back(std::move(mlp));
+    }
+    ThreadPool::setGlobalThreadCount(0);
+    expectSameParameters(trained[0], trained[1], 0.0);
+
+    reference.train(X, y, 4, 0.2, 16);
+    expectSameParameters(reference, trained[0], 1e-12);
+}
+
+namespace {
+    // MSE whose gradient fails, as a user-supplied loss might
+    class ThrowingLoss : public MSE {
+    public:
+        void derivative(MatrixView, MatrixView, Matrix&) const override {
+            throw std::runtime_error("loss failed");
+        }
+    };
+}
+
+// A shard or worker that throws hands the exception to the caller, and the network keeps working
+TEST(MLPTest, ParallelTrainingPropagatesExceptions) {
+    auto tanh = std::make_shared<Tanh>();
+    auto sigmoid = std::make_shared<Sigmoid>();
+    Matrix X(5, 40), y(2, 40);
+    X.randomize(-1.0, 1.0);
+    y.randomize(0.0, 1.0);
+
+    ThreadPool::setGlobalThreadCount(3);
+    MLP mlp({5, 16, 2}, {tanh, sigmoid}, 0.2, std::make_shared<ThrowingLoss>());
+    EXPECT_THROW(mlp.backpropagateParallel(X, y, 4), std::runtime_error);
+    EXPECT_THROW(mlp.train(X, y, 1, 0.2, 4, 3, TrainingMode::Hogwild), std::runtime_error);
+
+    mlp.loss_function = std::make_shared<MSE>();
+    EXPECT_NO_THROW(mlp.backpropagateParallel(X, y, 4));
+    EXPECT_NO_THROW(mlp.train(X, y, 1, 0.2, 4, 3, TrainingMode::Hogwild));
+    ThreadPool::setGlobalThreadCount(0);
+}
+
+// With one worker Hogwild is plain SGD; skipping the zero first-layer gradients changes nothing
+TEST(MLPTest, HogwildSingleWorkerMatchesSerialTraining) {
+    auto relu = std::make_shared<Relu>();
+    auto sigmoid = std::make_shared<Sigmoid>();
+    Matrix X(8, 24), y(2, 24);
+    for (int c = 0; c < 24; c++) {
+        X(c % 8, c) = 1.0;
+        X((c * 3 + 1) % 8, c) = -0.5;
+    }
+    y.randomize(0.0, 1.0);
+
+    // Inputs are read in place, so a column-major view of the same samples trains identically
+    const Matrix Xt = X.view().transposed();
+    const MatrixView columnMajorX = Xt.view().transposed();
+
+    MLP serial({8, 10, 2}, {relu, sigmoid}, 0.1, std::make_shared<MSE>());
+    MLP hogwild({8, 10, 2}, {relu, sigmoid}, 0.1, std::make_shared<MSE>());
+    MLP columnMajor({8, 10, 2}, {relu, sigmoid}, 0.1, std::make_shared<MSE>());
+    hogwild.weights = serial.weights;
+    columnMajor.weights = serial.weights;
+    for (int batch : {1, 4}) {
+        serial.train(X, y, 3, 0.1, batch);
+        hogwild.train(X, y, 3, 0.1, batch, 1, TrainingMode::Hogwild);
+        columnMajor.train(columnMajorX, y, 3, 0.1, batch, 1, TrainingMode::Hogwild);
+        expectSameParameters(serial, hogwild, 1e-12);
+        expectSameParameters(serial, columnMajor, 1e-12);
+    }
+}
+
+// Lock-free workers on a sparse problem still learn it
+TEST(MLPTest, HogwildConvergesOnSparseInputs) {
+    // Each sample activates three of 60 features, all from the half that names its class
+    const int features = 60, samples = 240;
+    Matrix X(features, samples), y(2, samples);
+    for (int c = 0; c < samples; c++) {
+        const int label = c % 2;
+        for (int k = 0; k < 3; k++) {
+            X(label * features / 2 + (c * 7 + k * 11) % (features / 2), c) = 1.0;
+        }
+        y(label, c) = 1.0;
+    }
+
+    ThreadPool::setGlobalThreadCount(4);
+    MLP mlp({features, 16, 2}, {std::make_shared<Relu>(), std::make_shared<Softmax>()}, 0.2,
+            std::make_shared<CrossEntropy>());
+    CrossEntropy ce;
+    const double before = ce.calculate(mlp.forward(X), y);
+    mlp.train(X, y, 20, 0.2, 1, 4, TrainingMode::Hogwild);
+    ThreadPool::setGlobalThreadCount(0);
+
+    const Matrix p = mlp.forward(X);
+    EXPECT_LT(ce.calculate(p, y), before * 0.1);
+    for (int c = 0; c < samples; c++) {
+        EXPECT_GT(p(c % 2, c), 0.5);
+    }
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../include/MappedMatrix.h"
+#include "../include/Matrix.h"
+#include "../include/MLP.h"
+#include "../include/activation_functions/Sigmoid.h"
+#include "../include/loss_functions/MSE.h"
+
+// Writes the raw bytes of values after headerBytes zero bytes and removes the file on destruction
+class TempFile
+{
+public:
+    template<typename T>
+    TempFile(const std::string& name, const std::vector<T>& values, const size_t headerBytes = 0)
+        : path((std::filesystem::temp_directory_path() / ("edgemlp_" + name + ".bin")).string())
+    {
+        std::ofstream out(path, std::ios::binary);
+        const std::vector<char> header(headerBytes, 0);
+        out.write(header.data(), static_cast<std::streamsize>(header.size()));
+        out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+    }
+
+    ~TempFile() { std::remove(path.c_str()); }
+
+    const std::string path;
+};
+
+static Matrix makeSequential(const int rows, const int cols)
+{
+    Matrix m(rows, cols);
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++)
+            m(i, j) = i * 10 + j;
+    return m;
+}
+
+static std::vector<double> toVector(const Matrix& m, const Layout layout)
+{
+    std::vector<double> values;
+    if (layout == Layout::RowMajor)
+    {
+        for (int i = 0; i < m.getRows(); i++)
+            for (int j = 0; j < m.getCols(); j++)
+                values.push_back(m(i, j));
+    }
+    else
+    {
+        for (int j = 0; j < m.getCols(); j++)
+            for (int i = 0; i < m.getRows(); i++)
+                values.push_back(m(i, j));
+    }
+    return values;
+}
+
+// Test that a row-major file reads back element for element
+TEST(MappedMatrixTest, RowMajorFile)
+{
+    const Matrix expected = makeSequential(3, 4);
+    const TempFile file("row_major", toVector(expected, Layout::RowMajor));
+
+    const MappedMatrix mapped(file.path, 3, 4);
+    EXPECT_EQ(mapped.getRows(), 3);
+    EXPECT_EQ(mapped.getCols(), 4);
+    EXPECT_TRUE(mapped.view().isContiguous());
+    const Matrix copy = mapped.view();
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 4; j++)
+            EXPECT_DOUBLE_EQ(copy(i, j), expected(i, j));
+    EXPECT_DOUBLE_EQ(mapped.col(2)(1, 0), 12.0);
+}
+
+// Test that a column-major file exposes contiguous columns and multiplies correctly
+TEST(MappedMatrixTest, ColumnMajorFile)
+{
+    const Matrix expected = makeSequential(5, 3);
+    const TempFile file("column_major", toVector(expected, Layout::ColumnMajor));
+
+    const MappedMatrix mapped(file.path, 5, 3, Layout::ColumnMajor);
+    const MatrixView view = mapped.view();
+    EXPECT_EQ(view.getLayout(), Layout::ColumnMajor);
+    EXPECT_FALSE(view.isContiguous());
+    EXPECT_DOUBLE_EQ(view(4, 1), 41.0);
+
+    const MatrixView column = mapped.col(1);
+    EXPECT_TRUE(column.isContiguous());
+    EXPECT_EQ(column.getData(), mapped.getData() + 5);
+    EXPECT_DOUBLE_EQ(column(3, 0), 31.0);
+
+    const Matrix copy = view;
+    const Matrix block = view.block(1, 1, 3, 2);
+    EXPECT_DOUBLE_EQ(copy(2, 2), 22.0);
+    EXPECT_DOUBLE_EQ(block(2, 1), 32.0);
+    EXPECT_DOUBLE_EQ(view.transposed()(2, 4), 42.0);
+
+    Matrix weights(2, 5);
+    weights.randomize(-1.0, 1.0);
+    const Matrix product = weights * view;
+    const Matrix reference = weights * expected;
+    const Matrix outer = view * weights.block(0, 0, 2, 3).transposed();
+    const Matrix outerReference = expected * Matrix(weights.block(0, 0, 2, 3).transposed());
+    for (int i = 0; i < 2; i++)
+        for (int j = 0; j < 3; j++)
+            EXPECT_NEAR(product(i, j), reference(i, j), 1e-12);
+    for (int i = 0; i < 5; i++)
+        for (int j = 0; j < 2; j++)
+            EXPECT_NEAR(outer(i, j), outerReference(i, j), 1e-12);
+}
+
+// Test header offsets and the errors for bad files and arguments
+TEST(MappedMatrixTest, OffsetAndErrors)
+{
+    const TempFile file("offset", toVector(makeSequential(2, 2), Layout::RowMajor), 16);
+
+    const MappedMatrix mapped(file.path, 2, 2, Layout::RowMajor, 16);
+    EXPECT_DOUBLE_EQ(mapped.view()(1, 1), 11.0);
+
+    EXPECT_THROW(MappedMatrix(file.path, 3, 2, Layout::RowMajor, 16), std::invalid_argument);
+    EXPECT_THROW(MappedMatrix(file.path, 2, 2, Layout::RowMajor, 3), std::invalid_argument);
+    EXPECT_THROW(MappedMatrix(file.path + ".missing", 2, 2), std::runtime_error);
+
+    MappedMatrix moved = MappedMatrix(file.path, 2, 2, Layout::RowMajor, 16);
+    const MappedMatrix target = std::move(moved);
+    EXPECT_EQ(moved.getData(), nullptr);
+    EXPECT_DOUBLE_EQ(target.view()(0, 1), 1.0);
+}
+
+// Test that training from a mapped dataset matches training from memory
+TEST(MappedMatrixTest, TrainOnMappedDataset)
+{
+    Matrix X(3, 8), y(1, 8);
+    X.randomize(-1.0, 1.0);
+    y.randomize(0.0, 1.0);
+    const TempFile xFile("train_x", toVector(X, Layout::ColumnMajor));
+    const TempFile yFile("train_y", toVector(y, Layout::ColumnMajor));
+    const MappedMatrix mappedX(xFile.path, 3, 8, Layout::ColumnMajor);
+    const MappedMatrix mappedY(yFile.path, 1, 8, Layout::ColumnMajor);
+
+    auto sigmoid = std::make_shared<Sigmoid>();
+    auto mse = std::make_shared<MSE>();
+    MLP fromFile({3, 4, 1}, {sigmoid, sigmoid}, 0.1, mse);
+    MLP fromMemory({3, 4, 1}, {sigmoid, sigmoid}, 0.1, mse);
+    fromFile.train(mappedX, mappedY, 2, 0.1);
+    fromMemory.train(X, y, 2, 0.1);
+
+    for (size_t l = 0; l < fromFile.weights.size(); l++)
+    {
+        const Matrix& a = fromFile.weights[l];
+        const Matrix& b = fromMemory.weights[l];
+        for (int i = 0; i < a.getRows(); i++)
+            for (int j = 0; j < a.getCols(); j++)
+                EXPECT_DOUBLE_EQ(a(i, j), b(i, j));
+    }
+}
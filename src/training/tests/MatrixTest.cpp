@@ -3,6 +3,7 @@
 #include <sstream>
 #include <cmath>
 #include <limits>
+#include <cstdint>
 
 // Test to verify matrix construction and dimensions
 TEST(MatrixTest, ConstructorAndDimensions) {
@@ -585,6 +586,26 @@ TEST(MatrixEdgeCaseTest, SumRowsSingleColumn)
     EXPECT_DOUBLE_EQ(result(2, 0), 3.0);
 }
 
+// Row sums into an existing column, and a column added back to every column
+TEST(MatrixEdgeCaseTest, SumRowsIntoAndAddToColumns)
+{
+    Matrix m(2, 3);
+    m(0, 0) = 1.0; m(0, 1) = 2.0; m(0, 2) = 3.0;
+    m(1, 0) = 4.0; m(1, 1) = 5.0; m(1, 2) = 6.0;
+
+    Matrix sums(2, 1);
+    m.sumRows(sums);
+    EXPECT_DOUBLE_EQ(sums(0, 0), 6.0);
+    EXPECT_DOUBLE_EQ(sums(1, 0), 15.0);
+    Matrix wrongShape(2, 2);
+    EXPECT_THROW(m.sumRows(wrongShape), std::invalid_argument);
+
+    m.addToColumns(sums);
+    EXPECT_DOUBLE_EQ(m(0, 2), 9.0);
+    EXPECT_DOUBLE_EQ(m(1, 0), 19.0);
+    EXPECT_THROW(m.addToColumns(wrongShape), std::invalid_argument);
+}
+
 // Test sumRows with single row
 TEST(MatrixEdgeCaseTest, SumRowsSingleRow)
 {
@@ -805,4 +826,378 @@ TEST(MatrixEdgeCaseTest, SubtractionFromSelf)
     EXPECT_DOUBLE_EQ(result.sum(), 0.0);
     EXPECT_DOUBLE_EQ(result(0, 0), 0.0);
     EXPECT_DOUBLE_EQ(result(1, 1), 0.0);
-}
\ No newline at end of file
+}
+
+// Test a compound expression evaluated in one fused pass
+TEST(MatrixExpressionTest, FusedCompoundExpression)
+{
+    Matrix a(2, 3), b(2, 3), c(2, 3);
+    for (int i = 0; i < 2; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            a(i, j) = i * 3 + j;
+            b(i, j) = 2.0 * (i + j);
+            c(i, j) = -1.0 * j;
+        }
+    }
+
+    Matrix result = a - b * 0.5 + c;
+
+    EXPECT_EQ(result.getRows(), 2);
+    EXPECT_EQ(result.getCols(), 3);
+    for (int i = 0; i < 2; i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            EXPECT_DOUBLE_EQ(result(i, j), a(i, j) - b(i, j) * 0.5 + c(i, j));
+        }
+    }
+}
+
+// Test assigning an expression that reads the target matrix
+TEST(MatrixExpressionTest, AssignmentToOperand)
+{
+    Matrix w(2, 2);
+    w(0, 0) = 1.0; w(0, 1) = 2.0;
+    w(1, 0) = 3.0; w(1, 1) = 4.0;
+
+    Matrix grad(2, 2);
+    grad(0, 0) = 10.0; grad(0, 1) = 20.0;
+    grad(1, 0) = 30.0; grad(1, 1) = 40.0;
+
+    w = w - grad * 0.1;
+
+    EXPECT_DOUBLE_EQ(w(0, 0), 0.0);
+    EXPECT_DOUBLE_EQ(w(0, 1), 0.0);
+    EXPECT_DOUBLE_EQ(w(1, 0), 0.0);
+    EXPECT_DOUBLE_EQ(w(1, 1), 0.0);
+}
+
+// Test that shape mismatches inside a nested expression still throw
+TEST(MatrixExpressionTest, NestedIncompatibleThrows)
+{
+    Matrix a(2, 2), b(2, 2), c(3, 2);
+
+    EXPECT_THROW(Matrix(a + b * 2.0 - c), std::invalid_argument);
+    EXPECT_THROW(Matrix((a + b).hadamardProduct(c)), std::invalid_argument);
+}
+
+// Test compound assignment operators
+TEST(MatrixInPlaceTest, CompoundOperators)
+{
+    Matrix m(2, 2);
+    m(0, 0) = 1.0; m(0, 1) = 2.0;
+    m(1, 0) = 3.0; m(1, 1) = 4.0;
+
+    Matrix other(2, 2);
+    other(0, 0) = 1.0; other(0, 1) = 1.0;
+    other(1, 0) = 1.0; other(1, 1) = 1.0;
+
+    m += other;
+    EXPECT_DOUBLE_EQ(m(1, 1), 5.0);
+    m -= other * 2.0;
+    EXPECT_DOUBLE_EQ(m(1, 1), 3.0);
+    m *= 2.0;
+    EXPECT_DOUBLE_EQ(m(0, 0), 0.0);
+    EXPECT_DOUBLE_EQ(m(0, 1), 2.0);
+    EXPECT_DOUBLE_EQ(m(1, 0), 4.0);
+    EXPECT_DOUBLE_EQ(m(1, 1), 6.0);
+
+    Matrix wrong(3, 2);
+    EXPECT_THROW(m += wrong, std::invalid_argument);
+}
+
+// Test axpy and in-place Hadamard product
+TEST(MatrixInPlaceTest, AxpyAndHadamardInPlace)
+{
+    Matrix y(1, 3);
+    y(0, 0) = 1.0; y(0, 1) = 2.0; y(0, 2) = 3.0;
+    Matrix x(1, 3);
+    x(0, 0) = 10.0; x(0, 1) = 20.0; x(0, 2) = 30.0;
+
+    y.axpy(-0.5, x);
+    EXPECT_DOUBLE_EQ(y(0, 0), -4.0);
+    EXPECT_DOUBLE_EQ(y(0, 1), -8.0);
+    EXPECT_DOUBLE_EQ(y(0, 2), -12.0);
+
+    y.hadamardInPlace(x);
+    EXPECT_DOUBLE_EQ(y(0, 0), -40.0);
+    EXPECT_DOUBLE_EQ(y(0, 1), -160.0);
+    EXPECT_DOUBLE_EQ(y(0, 2), -360.0);
+
+    Matrix wrong(3, 1);
+    EXPECT_THROW(y.axpy(1.0, wrong), std::invalid_argument);
+    EXPECT_THROW(y.hadamardInPlace(wrong), std::invalid_argument);
+}
+
+// Test gemm with transposed operands against explicit transposes
+TEST(MatrixInPlaceTest, GemmTransposes)
+{
+    Matrix a(3, 4), b(3, 5), c(4, 5);
+    a.randomize(-1.0, 1.0);
+    b.randomize(-2.0, 2.0);
+    c.randomize(0.0, 1.0);
+
+    Matrix expected = a.transpose() * b;
+    expected = expected * 2.0 + c * 0.5;
+    gemm(c, a, b, 2.0, 0.5, true, false);
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 5; j++)
+            EXPECT_NEAR(c(i, j), expected(i, j), 1e-12);
+
+    Matrix outer(3, 3);
+    gemm(outer, b, b, 1.0, 0.0, false, true);
+    Matrix expectedOuter = b * b.transpose();
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            EXPECT_NEAR(outer(i, j), expectedOuter(i, j), 1e-12);
+
+    Matrix both(5, 4);
+    gemm(both, b, a, 1.0, 0.0, true, false);
+    Matrix bothT(4, 5);
+    gemm(bothT, a, b, 1.0, 0.0, true, false);
+    for (int i = 0; i < 5; i++)
+        for (int j = 0; j < 4; j++)
+            EXPECT_NEAR(both(i, j), bothT(j, i), 1e-12);
+
+    Matrix wrongShape(2, 2);
+    EXPECT_THROW(gemm(wrongShape, a, b, 1.0, 0.0, true, false), std::invalid_argument);
+    EXPECT_THROW(gemm(c, a, b), std::invalid_argument);
+}
+
+// Test the fused transposed products against explicit transposes
+TEST(MatrixInPlaceTest, TransposedProducts)
+{
+    Matrix a(6, 4), b(6, 3), c(5, 4);
+    a.randomize(-1.0, 1.0);
+    b.randomize(-1.0, 1.0);
+    c.randomize(-1.0, 1.0);
+
+    const Matrix atb = a.transposeMultiply(b);
+    const Matrix expectedAtb = a.transpose() * b;
+    ASSERT_EQ(atb.getRows(), 4);
+    ASSERT_EQ(atb.getCols(), 3);
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 3; j++)
+            EXPECT_NEAR(atb(i, j), expectedAtb(i, j), 1e-12);
+
+    const Matrix act = a.multiplyTranspose(c);
+    const Matrix expectedAct = a * c.transpose();
+    ASSERT_EQ(act.getRows(), 6);
+    ASSERT_EQ(act.getCols(), 5);
+    for (int i = 0; i < 6; i++)
+        for (int j = 0; j < 5; j++)
+            EXPECT_NEAR(act(i, j), expectedAct(i, j), 1e-12);
+
+    EXPECT_THROW(a.transposeMultiply(c), std::invalid_argument);
+    EXPECT_THROW(a.multiplyTranspose(b), std::invalid_argument);
+}
+
+// Test element-wise arithmetic and products on single-precision matrices
+TEST(MatrixTypeTest, FloatArithmetic)
+{
+    MatrixF a(2, 3), b(3, 2);
+    for (int i = 0; i < 2; i++)
+        for (int j = 0; j < 3; j++)
+        {
+            a(i, j) = static_cast<float>(i + j) * 0.5f;
+            b(j, i) = static_cast<float>(i - j);
+        }
+
+    const MatrixF product = a * b;
+    const Matrix productD = [&]
+    {
+        Matrix ad(2, 3), bd(3, 2);
+        for (int i = 0; i < 2; i++)
+            for (int j = 0; j < 3; j++)
+            {
+                ad(i, j) = a(i, j);
+                bd(j, i) = b(j, i);
+            }
+        return ad * bd;
+    }();
+    for (int i = 0; i < 2; i++)
+        for (int j = 0; j < 2; j++)
+            EXPECT_FLOAT_EQ(product(i, j), static_cast<float>(productD(i, j)));
+
+    MatrixF c = a * 2.0f + a - a.hadamardProduct(a);
+    EXPECT_FLOAT_EQ(c(1, 2), 1.5f * 2.0f + 1.5f - 1.5f * 1.5f);
+    c.axpy(-1.0f, a);
+    EXPECT_FLOAT_EQ(c(1, 2), 1.5f * 2.0f - 1.5f * 1.5f);
+    EXPECT_FLOAT_EQ(a.sum(), 4.5f);
+}
+
+// Test that int8 products and sums accumulate into int32 without wrapping
+TEST(MatrixTypeTest, Int8AccumulatesInInt32)
+{
+    MatrixI8 a(2, 64), b(64, 3);
+    for (int p = 0; p < 64; p++)
+    {
+        a(0, p) = 127;
+        a(1, p) = -128;
+        for (int j = 0; j < 3; j++)
+            b(p, j) = static_cast<int8_t>(j == 2 ? -128 : 100 + j);
+    }
+
+    const MatrixI32 product = a * b;
+    EXPECT_EQ(product(0, 0), 64 * 127 * 100);
+    EXPECT_EQ(product(0, 1), 64 * 127 * 101);
+    EXPECT_EQ(product(1, 2), 64 * 128 * 128);
+
+    EXPECT_EQ(a.sum(), 64 * 127 - 64 * 128);
+    const MatrixI32 rowSums = a.sumRows();
+    EXPECT_EQ(rowSums(0, 0), 64 * 127);
+    EXPECT_EQ(rowSums(1, 0), -64 * 128);
+
+    // Large enough to go through the packed path
+    MatrixI8 big(40, 40);
+    for (int i = 0; i < 40; i++)
+        for (int j = 0; j < 40; j++)
+            big(i, j) = static_cast<int8_t>((i * 7 + j * 3) % 255 - 127);
+    const MatrixI32 square = big * big;
+    int32_t expected = 0;
+    for (int p = 0; p < 40; p++)
+        expected += static_cast<int32_t>(big(5, p)) * big(p, 9);
+    EXPECT_EQ(square(5, 9), expected);
+}
+
+// Test int32 element-wise operations and that int8 prints as numbers
+TEST(MatrixTypeTest, IntegerElementwiseAndPrinting)
+{
+    MatrixI32 a(1, 3), b(1, 3);
+    a(0, 0) = 1; a(0, 1) = -2; a(0, 2) = 3;
+    b(0, 0) = 4; b(0, 1) = 5; b(0, 2) = -6;
+
+    const MatrixI32 c = a * 3 + b - a.hadamardProduct(b);
+    EXPECT_EQ(c(0, 0), 3 + 4 - 4);
+    EXPECT_EQ(c(0, 1), -6 + 5 + 10);
+    EXPECT_EQ(c(0, 2), 9 - 6 + 18);
+
+    MatrixI8 q(1, 1);
+    q(0, 0) = 65;
+    std::ostringstream os;
+    os << q;
+    EXPECT_NE(os.str().find("65"), std::string::npos);
+}
+
+static bool isCacheLineAligned(const void* p)
+{
+    return reinterpret_cast<std::uintptr_t>(p) % 64 == 0;
+}
+
+// Test that storage is cache-line aligned and padded rows start aligned too
+TEST(MatrixLayoutTest, AlignedAndPaddedStorage)
+{
+    const Matrix tight(3, 5);
+    EXPECT_TRUE(isCacheLineAligned(tight.getData()));
+    EXPECT_EQ(tight.getLeadingDimension(), 5);
+    EXPECT_TRUE(isCacheLineAligned(Matrix(tight).getData()));
+
+    const Matrix padded = Matrix::padded(3, 5);
+    EXPECT_EQ(padded.getLeadingDimension(), 8);
+    EXPECT_FALSE(padded.isContiguous());
+    for (int i = 0; i < 3; i++)
+        EXPECT_TRUE(isCacheLineAligned(&padded.getData()[i * padded.getLeadingDimension()]));
+
+    EXPECT_EQ(MatrixF::padded(2, 17).getLeadingDimension(), 32);
+    EXPECT_EQ(MatrixI8::padded(2, 3).getLeadingDimension(), 64);
+    EXPECT_EQ(Matrix::withLeadingDimension(2, 3, 7).getLeadingDimension(), 7);
+    EXPECT_THROW(Matrix::withLeadingDimension(2, 3, 2), std::invalid_argument);
+}
+
+// Test that element access, arithmetic and products see through the padding
+TEST(MatrixLayoutTest, PaddedMatrixBehavesLikeTight)
+{
+    Matrix tight(3, 5);
+    tight.randomize(-1.0, 1.0);
+    Matrix padded = Matrix::padded(3, 5);
+    padded = tight;
+    EXPECT_EQ(padded.getLeadingDimension(), 5);
+
+    padded = Matrix::padded(3, 5);
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 5; j++)
+            padded(i, j) = tight(i, j);
+    EXPECT_DOUBLE_EQ(padded.getData()[2 * padded.getLeadingDimension() + 4], tight(2, 4));
+    EXPECT_DOUBLE_EQ(padded.sum(), tight.sum());
+    EXPECT_DOUBLE_EQ(padded.mean(), tight.mean());
+    EXPECT_DOUBLE_EQ(padded.sumRows()(1, 0), tight.sumRows()(1, 0));
+
+    Matrix weights(4, 3);
+    weights.randomize(-1.0, 1.0);
+    const Matrix product = weights * padded;
+    const Matrix expected = weights * tight;
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 5; j++)
+            EXPECT_NEAR(product(i, j), expected(i, j), 1e-12);
+
+    Matrix out = Matrix::padded(4, 5);
+    gemm(out, weights, padded);
+    EXPECT_EQ(out.getLeadingDimension(), 8);
+    EXPECT_NEAR(out(3, 4), expected(3, 4), 1e-12);
+
+    padded += tight;
+    padded *= 0.5;
+    padded.axpy(-1.0, tight);
+    padded.hadamardInPlace(tight);
+    padded += tight * 2.0;
+    padded.applyFunction([](const double x) { return x + 1.0; });
+    const Matrix copy = padded;
+    EXPECT_EQ(copy.getLeadingDimension(), 8);
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 5; j++)
+            EXPECT_NEAR(copy(i, j), 2.0 * tight(i, j) + 1.0, 1e-12);
+
+    // Padding never picks up values
+    for (int i = 0; i < 3; i++)
+        for (int j = 5; j < 8; j++)
+            EXPECT_EQ(copy.getData()[i * 8 + j], 0.0);
+
+    // Expressions over a padded operand and into a padded target
+    const Matrix sum = copy + tight;
+    EXPECT_EQ(sum.getLeadingDimension(), 5);
+    EXPECT_NEAR(sum(2, 3), copy(2, 3) + tight(2, 3), 1e-12);
+    padded = tight - copy;
+    EXPECT_EQ(padded.getLeadingDimension(), 8);
+    EXPECT_NEAR(padded(1, 4), tight(1, 4) - copy(1, 4), 1e-12);
+    EXPECT_NEAR(Matrix(padded.col(4))(2, 0), padded(2, 4), 1e-12);
+}
+
+// Test that callable map/zipMap match the std::function overloads, serial and parallel
+TEST(MatrixMapTest, CallableOverloads)
+{
+    Matrix m(300, 257);
+    m.randomize(-2.0, 2.0);
+    const std::function<double(double)> square = [](const double x) { return x * x; };
+
+    const Matrix expected = m.map(square);
+    const Matrix serial = m.map([](const double x) { return x * x; });
+    const Matrix parallel = m.map([](const double x) { return x * x; }, Execution::Parallel);
+    for (int i = 0; i < 300; i += 7)
+        for (int j = 0; j < 257; j += 5)
+        {
+            EXPECT_DOUBLE_EQ(serial(i, j), expected(i, j));
+            EXPECT_DOUBLE_EQ(parallel(i, j), expected(i, j));
+        }
+
+    const Matrix zipped = m.zipMap(expected, [](const double a, const double b) { return b - a; },
+                                   Execution::Parallel);
+    EXPECT_DOUBLE_EQ(zipped(299, 256), expected(299, 256) - m(299, 256));
+    EXPECT_THROW(m.zipMap(Matrix(2, 2), std::minus<>()), std::invalid_argument);
+
+    // Serial execution visits elements in order, so stateful callables are allowed
+    Matrix padded = Matrix::padded(3, 5);
+    int counter = 0;
+    padded.applyFunction([&counter](double) { return counter++; });
+    EXPECT_DOUBLE_EQ(padded(2, 4), 14.0);
+    EXPECT_EQ(padded.getData()[7], 0.0);
+
+    const Matrix halved = padded.zipMap(padded, [](const double a, const double b) { return (a + b) / 4.0; });
+    EXPECT_EQ(halved.getLeadingDimension(), 8);
+    EXPECT_DOUBLE_EQ(halved(1, 3), 4.0);
+
+    MatrixI8 bytes(2, 2);
+    bytes(1, 1) = 3;
+    EXPECT_EQ(bytes.map([](const int8_t x) { return static_cast<int8_t>(-x); })(1, 1), -3);
+}
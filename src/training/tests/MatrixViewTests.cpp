@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include "../include/Matrix.h"
+#include "../include/MatrixView.h"
+#include "../include/MLP.h"
+#include "../include/activation_functions/Sigmoid.h"
+#include "../include/loss_functions/MSE.h"
+
+static Matrix makeSequential(const int rows, const int cols)
+{
+    Matrix m(rows, cols);
+    for (int i = 0; i < rows; i++)
+    {
+        for (int j = 0; j < cols; j++)
+        {
+            m(i, j) = i * 10 + j;
+        }
+    }
+    return m;
+}
+
+// Test that slices point into the original storage
+TEST(MatrixViewTest, SlicesShareStorage)
+{
+    const Matrix m = makeSequential(4, 5);
+
+    const MatrixView column = m.col(2);
+    EXPECT_EQ(column.getRows(), 4);
+    EXPECT_EQ(column.getCols(), 1);
+    EXPECT_EQ(column.getLeadingDimension(), 5);
+    EXPECT_EQ(column.getData(), m.getData() + 2);
+    EXPECT_DOUBLE_EQ(column(3, 0), 32.0);
+
+    const MatrixView range = m.colRange(1, 4);
+    EXPECT_EQ(range.getCols(), 3);
+    EXPECT_DOUBLE_EQ(range(2, 0), 21.0);
+    EXPECT_DOUBLE_EQ(range(2, 2), 23.0);
+    EXPECT_FALSE(range.isContiguous());
+
+    const MatrixView block = m.block(1, 2, 2, 3);
+    EXPECT_EQ(block.getRows(), 2);
+    EXPECT_EQ(block.getCols(), 3);
+    EXPECT_DOUBLE_EQ(block(0, 0), 12.0);
+    EXPECT_DOUBLE_EQ(block(1, 2), 24.0);
+
+    // Slicing a view stays relative to that view
+    EXPECT_DOUBLE_EQ(block.col(1)(1, 0), 23.0);
+    EXPECT_TRUE(m.block(1, 0, 2, 5).isContiguous());
+}
+
+// Test that out-of-range slices throw
+TEST(MatrixViewTest, OutOfRangeThrows)
+{
+    const Matrix m(3, 4);
+
+    EXPECT_THROW(m.col(4), std::out_of_range);
+    EXPECT_THROW(m.col(-1), std::out_of_range);
+    EXPECT_THROW(m.colRange(2, 5), std::out_of_range);
+    EXPECT_THROW(m.colRange(3, 2), std::out_of_range);
+    EXPECT_THROW(m.block(2, 0, 2, 1), std::out_of_range);
+    EXPECT_THROW(m.block(0, 3, 1, 2), std::out_of_range);
+}
+
+// Test that a view materializes into a Matrix and takes part in expressions
+TEST(MatrixViewTest, CopyAndExpressions)
+{
+    const Matrix m = makeSequential(3, 4);
+
+    const Matrix copy = m.block(1, 1, 2, 2);
+    EXPECT_EQ(copy.getRows(), 2);
+    EXPECT_EQ(copy.getCols(), 2);
+    EXPECT_DOUBLE_EQ(copy(0, 0), 11.0);
+    EXPECT_DOUBLE_EQ(copy(1, 1), 22.0);
+
+    const Matrix diff = m.col(3) - m.col(1) * 2.0;
+    EXPECT_DOUBLE_EQ(diff(0, 0), 3.0 - 2.0);
+    EXPECT_DOUBLE_EQ(diff(2, 0), 23.0 - 42.0);
+
+    EXPECT_THROW(Matrix(m.col(0) + m.colRange(0, 2)), std::invalid_argument);
+}
+
+// Test that assigning a matrix from views of its own storage reads the old elements
+TEST(MatrixViewTest, AssignFromOwnViews)
+{
+    Matrix a = makeSequential(4, 5);
+    a = a.col(1) * 2.0;
+    ASSERT_EQ(a.getRows(), 4);
+    ASSERT_EQ(a.getCols(), 1);
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_DOUBLE_EQ(a(i, 0), 2.0 * (i * 10 + 1));
+    }
+
+    Matrix b = makeSequential(4, 5);
+    b = b.colRange(1, 3) + b.colRange(2, 4);
+    ASSERT_EQ(b.getCols(), 2);
+    EXPECT_DOUBLE_EQ(b(3, 0), 31.0 + 32.0);
+    EXPECT_DOUBLE_EQ(b(3, 1), 32.0 + 33.0);
+
+    // A view of another matrix is not copied first and still assigns normally
+    Matrix c = makeSequential(2, 2);
+    const Matrix d = makeSequential(2, 2);
+    c = c + d.view();
+    EXPECT_DOUBLE_EQ(c(1, 1), 22.0);
+}
+
+// Test that a matrix can be assigned or updated from its own transpose
+TEST(MatrixViewTest, AssignFromOwnTranspose)
+{
+    Matrix m(2, 3);
+    for (int k = 0; k < 6; k++)
+    {
+        m(k / 3, k % 3) = k;
+    }
+    m = m.view().transposed();
+    ASSERT_EQ(m.getRows(), 3);
+    ASSERT_EQ(m.getCols(), 2);
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_DOUBLE_EQ(m(i, 0), i);
+        EXPECT_DOUBLE_EQ(m(i, 1), i + 3);
+    }
+
+    // Large enough to be evaluated in parallel spans
+    Matrix big = makeSequential(300, 200);
+    const Matrix original = big;
+    big = big.view().transposed();
+    Matrix square = makeSequential(250, 250);
+    const Matrix squareOriginal = square;
+    square += square.view().transposed();
+    square -= square.view().transposed() * 0.5;
+    for (int i = 0; i < 200; i++)
+    {
+        for (int j = 0; j < 300; j++)
+        {
+            ASSERT_DOUBLE_EQ(big(i, j), original(j, i));
+        }
+    }
+    for (int i = 0; i < 250; i++)
+    {
+        for (int j = 0; j < 250; j++)
+        {
+            const double symmetric = squareOriginal(i, j) + squareOriginal(j, i);
+            ASSERT_DOUBLE_EQ(square(i, j), symmetric * 0.5);
+        }
+    }
+}
+
+// Test products on strided views against products on copies
+TEST(MatrixViewTest, ProductsReadViewsInPlace)
+{
+    Matrix big(40, 50);
+    big.randomize(-1.0, 1.0);
+    Matrix weights(7, 40);
+    weights.randomize(-1.0, 1.0);
+
+    const MatrixView batch = big.colRange(5, 18);
+    const Matrix expected = weights * Matrix(batch);
+    const Matrix result = weights * batch;
+    ASSERT_EQ(result.getRows(), 7);
+    ASSERT_EQ(result.getCols(), 13);
+    for (int i = 0; i < 7; i++)
+        for (int j = 0; j < 13; j++)
+            EXPECT_NEAR(result(i, j), expected(i, j), 1e-12);
+
+    const Matrix blockProduct = big.block(0, 0, 3, 40) * big.block(0, 10, 40, 2);
+    const Matrix blockExpected = Matrix(big.block(0, 0, 3, 40)) * Matrix(big.block(0, 10, 40, 2));
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 2; j++)
+            EXPECT_NEAR(blockProduct(i, j), blockExpected(i, j), 1e-12);
+
+    EXPECT_THROW(weights * big.colRange(0, 2).block(0, 0, 3, 2), std::invalid_argument);
+}
+
+// Test that training on dataset columns matches training on copied columns
+TEST(MatrixViewTest, MLPAcceptsColumnViews)
+{
+    Matrix X(3, 6), y(2, 6);
+    X.randomize(-1.0, 1.0);
+    y.randomize(0.0, 1.0);
+
+    auto sigmoid = std::make_shared<Sigmoid>();
+    auto mse = std::make_shared<MSE>();
+    MLP fromViews({3, 5, 2}, {sigmoid, sigmoid}, 0.1, mse);
+    MLP fromCopies({3, 5, 2}, {sigmoid, sigmoid}, 0.1, mse);
+
+    for (int i = 0; i < 6; i++)
+    {
+        fromViews.backpropagate(X.col(i), y.col(i));
+        fromCopies.backpropagate(Matrix(X.col(i)), Matrix(y.col(i)));
+    }
+
+    const Matrix a = fromViews.forward(X.col(2));
+    const Matrix b = fromCopies.forward(Matrix(X.col(2)));
+    EXPECT_DOUBLE_EQ(a(0, 0), b(0, 0));
+    EXPECT_DOUBLE_EQ(a(1, 0), b(1, 0));
+    EXPECT_DOUBLE_EQ(mse->calculate(a, y.col(2)), mse->calculate(b, Matrix(y.col(2))));
+}
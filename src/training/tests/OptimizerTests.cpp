@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+#include "../include/MLP.h"
+#include "../include/Matrix.h"
+#include "../include/activation_functions/Sigmoid.h"
+#include "../include/activation_functions/Tanh.h"
+#include "../include/loss_functions/MSE.h"
+#include "../include/optimizers/Adam.h"
+#include "../include/optimizers/AdamW.h"
+#include "../include/optimizers/Momentum.h"
+#include "../include/optimizers/Nesterov.h"
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    // The gradient of step t, different every step so the state matters
+    Matrix gradientAt(const int step) {
+        Matrix g(3, 5);
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 5; j++) {
+                g(i, j) = std::sin(1.0 + i * 5 + j + 0.7 * step);
+            }
+        }
+        return g;
+    }
+
+    Matrix initialParameters() {
+        Matrix p(3, 5);
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 5; j++) {
+                p(i, j) = 0.25 * (i - j);
+            }
+        }
+        return p;
+    }
+
+    void expectMatrixNear(const Matrix& expected, const Matrix& actual, const double tolerance) {
+        ASSERT_EQ(expected.getRows(), actual.getRows());
+        ASSERT_EQ(expected.getCols(), actual.getCols());
+        for (int i = 0; i < expected.getRows(); i++) {
+            for (int j = 0; j < expected.getCols(); j++) {
+                EXPECT_NEAR(expected(i, j), actual(i, j), tolerance) << "(" << i << ", " << j << ")";
+            }
+        }
+    }
+
+    // Momentum written out element by element
+    Matrix momentumReference(const int steps, const double lr, const double beta, const bool nesterov) {
+        Matrix p = initialParameters();
+        Matrix v(3, 5);
+        for (int t = 0; t < steps; t++) {
+            const Matrix g = gradientAt(t);
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 5; j++) {
+                    v(i, j) = beta * v(i, j) + g(i, j);
+                    p(i, j) -= lr * (nesterov ? g(i, j) + beta * v(i, j) : v(i, j));
+                }
+            }
+        }
+        return p;
+    }
+
+    // Adam as in the paper, with explicitly bias-corrected moments, and AdamW's decoupled decay
+    Matrix adamReference(const int steps, const double lr, const double weightDecay) {
+        const double beta1 = 0.9, beta2 = 0.999, epsilon = 1e-8;
+        Matrix p = initialParameters();
+        Matrix m(3, 5), v(3, 5);
+        for (int t = 1; t <= steps; t++) {
+            const Matrix g = gradientAt(t - 1);
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 5; j++) {
+                    m(i, j) = beta1 * m(i, j) + (1 - beta1) * g(i, j);
+                    v(i, j) = beta2 * v(i, j) + (1 - beta2) * g(i, j) * g(i, j);
+                    const double mHat = m(i, j) / (1 - std::pow(beta1, t));
+                    const double vHat = v(i, j) / (1 - std::pow(beta2, t));
+                    p(i, j) -= lr * weightDecay * p(i, j);
+                    p(i, j) -= lr * mHat / (std::sqrt(vHat) + epsilon);
+                }
+            }
+        }
+        return p;
+    }
+
+    Matrix runOptimizer(Optimizer& optimizer, const int steps, const double lr) {
+        Matrix p = initialParameters();
+        for (int t = 0; t < steps; t++) {
+            optimizer.beginStep();
+            optimizer.update(0, p, gradientAt(t), lr);
+        }
+        return p;
+    }
+}
+
+TEST(OptimizerTest, MomentumMatchesReference) {
+    Momentum momentum(0.9);
+    expectMatrixNear(momentumReference(5, 0.1, 0.9, false), runOptimizer(momentum, 5, 0.1), 1e-12);
+    EXPECT_EQ(momentum.name(), "Momentum");
+}
+
+TEST(OptimizerTest, NesterovMatchesReference) {
+    Nesterov nesterov(0.8);
+    expectMatrixNear(momentumReference(5, 0.1, 0.8, true), runOptimizer(nesterov, 5, 0.1), 1e-12);
+    EXPECT_EQ(nesterov.name(), "Nesterov");
+}
+
+TEST(OptimizerTest, AdamMatchesReference) {
+    Adam adam;
+    expectMatrixNear(adamReference(6, 0.01, 0.0), runOptimizer(adam, 6, 0.01), 1e-12);
+    EXPECT_EQ(adam.steps(), 6);
+
+    // A reset optimizer starts over from zeroed moments and step 1
+    adam.reset();
+    EXPECT_EQ(adam.steps(), 0);
+    expectMatrixNear(adamReference(2, 0.01, 0.0), runOptimizer(adam, 2, 0.01), 1e-12);
+}
+
+TEST(OptimizerTest, AdamWMatchesReference) {
+    AdamW adamW(0.1);
+    expectMatrixNear(adamReference(6, 0.01, 0.1), runOptimizer(adamW, 6, 0.01), 1e-12);
+    EXPECT_EQ(adamW.name(), "AdamW");
+}
+
+// With a zero gradient the moments stay zero and only the decay moves the parameters
+TEST(OptimizerTest, AdamWDecayIsDecoupledFromGradient) {
+    AdamW adamW(0.5);
+    Matrix p = initialParameters();
+    const Matrix zero(3, 5);
+    for (int t = 0; t < 3; t++) {
+        adamW.beginStep();
+        adamW.update(0, p, zero, 0.1);
+    }
+    Matrix expected = initialParameters();
+    expected *= std::pow(1 - 0.1 * 0.5, 3);
+    expectMatrixNear(expected, p, 1e-15);
+}
+
+// Each slot keeps its own state, whatever order the slots are updated in
+TEST(OptimizerTest, StateIsKeptPerSlot) {
+    Momentum shared(0.9), first(0.9), second(0.9);
+    Matrix a = initialParameters(), b = initialParameters();
+    Matrix expectedA = initialParameters(), expectedB = initialParameters();
+    for (int t = 0; t < 4; t++) {
+        const Matrix g = gradientAt(t);
+        Matrix gB = gradientAt(10 - t);
+        shared.update(3, b, gB, 0.05);
+        shared.update(1, a, g, 0.05);
+        first.update(0, expectedA, g, 0.05);
+        second.update(0, expectedB, gB, 0.05);
+    }
+    expectMatrixNear(expectedA, a, 0.0);
+    expectMatrixNear(expectedB, b, 0.0);
+
+    const Matrix wrongShape(5, 3);
+    EXPECT_THROW(shared.update(1, a, wrongShape, 0.05), std::invalid_argument);
+}
+
+TEST(OptimizerTest, FloatAdamMatchesDouble) {
+    AdamF adamF;
+    Adam adam;
+    MatrixF pF(3, 5);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 5; j++) {
+            pF(i, j) = static_cast<float>(initialParameters()(i, j));
+        }
+    }
+    for (int t = 0; t < 4; t++) {
+        MatrixF gF(3, 5);
+        const Matrix g = gradientAt(t);
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 5; j++) {
+                gF(i, j) = static_cast<float>(g(i, j));
+            }
+        }
+        adamF.beginStep();
+        adamF.update(0, pF, gF, 0.01f);
+    }
+    const Matrix expected = runOptimizer(adam, 4, 0.01);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 5; j++) {
+            EXPECT_NEAR(expected(i, j), pF(i, j), 1e-5);
+        }
+    }
+}
+
+namespace {
+    // Full-batch steps until the XOR loss drops below target; returns the number of epochs taken
+    int epochsToReach(MLP& mlp, const Matrix& X, const Matrix& y, const double target, const int maxEpochs) {
+        for (int epoch = 1; epoch <= maxEpochs; epoch++) {
+            mlp.backpropagate(X, y);
+            if (mlp.loss_function->calculate(mlp.forward(X), y) < target) {
+                return epoch;
+            }
+        }
+        return maxEpochs + 1;
+    }
+}
+
+// The same network from the same initial weights reaches the target loss in a
+// fraction of the epochs with Adam than with plain SGD
+TEST(OptimizerTest, AdamConvergesFasterThanSgd) {
+    auto tanh = std::make_shared<Tanh>();
+    auto sigmoid = std::make_shared<Sigmoid>();
+    MLP sgd({2, 8, 1}, {tanh, sigmoid}, 0.5, std::make_shared<MSE>());
+    MLP adam({2, 8, 1}, {tanh, sigmoid}, 0.05, std::make_shared<MSE>());
+    adam.weights = sgd.weights;
+    adam.biases = sgd.biases;
+    adam.optimizer = std::make_shared<Adam>();
+
+    Matrix X(2, 4), y(1, 4);
+    for (int c = 0; c < 4; c++) {
+        X(0, c) = c >> 1;
+        X(1, c) = c & 1;
+        y(0, c) = X(0, c) != X(1, c) ? 1.0 : 0.0;
+    }
+    const int sgdEpochs = epochsToReach(sgd, X, y, 0.01, 20000);
+    const int adamEpochs = epochsToReach(adam, X, y, 0.01, 20000);
+    EXPECT_LE(adamEpochs, 20000);
+    EXPECT_LT(adamEpochs * 4, sgdEpochs) << "Adam " << adamEpochs << " epochs, SGD " << sgdEpochs;
+}
+
+TEST(OptimizerTest, HogwildRejectsOptimizer) {
+    auto sigmoid = std::make_shared<Sigmoid>();
+    MLP mlp({2, 3, 1}, {sigmoid, sigmoid}, 0.1, std::make_shared<MSE>());
+    mlp.optimizer = std::make_shared<Momentum>();
+    Matrix X(2, 4), y(1, 4);
+    EXPECT_THROW(mlp.train(X, y, 1, 0.1, 1, 2, TrainingMode::Hogwild), std::invalid_argument);
+}
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../include/Matrix.h"
+#include "../include/ThreadPool.h"
+#include "../include/kernels/Reduction.h"
+
+// Restores the global reduction mode and thread count when a test ends
+class ReductionTest : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        kernels::setReductionMode(kernels::ReductionMode::Fast);
+        ThreadPool::setGlobalThreadCount(0);
+    }
+};
+
+// Test that pairwise summation keeps float error small where a running sum drifts
+TEST_F(ReductionTest, PairwiseErrorStaysBounded)
+{
+    const size_t n = 1 << 22;
+    std::vector<float> values(n, 0.1f);
+    double exact = 0;
+    float running = 0;
+    for (const float v : values)
+    {
+        exact += v;
+        running += v;
+    }
+
+    const float pairwise = kernels::pairwiseSum(values.data(), n);
+    EXPECT_LT(std::abs(pairwise - exact) / exact, 1e-6);
+    EXPECT_LT(std::abs(pairwise - exact), std::abs(running - exact) / 100);
+
+    MatrixF m(1024, 4096);
+    m += 0.1f;
+    EXPECT_NEAR(m.sum(), exact, exact * 1e-6);
+    EXPECT_NEAR(m.mean(), 0.1, 1e-7);
+}
+
+// Test that reproducible mode gives bit-identical sums for any thread count and matches serial
+TEST_F(ReductionTest, ReproducibleAcrossThreadCounts)
+{
+    std::mt19937 eng(7);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+    std::vector<double> values(3000017);
+    for (double& v : values)
+        v = dist(eng);
+
+    kernels::setReductionMode(kernels::ReductionMode::Reproducible);
+    const double serial = kernels::pairwiseSum(values.data(), values.size());
+    for (const int threads : {1, 2, 3, 8})
+    {
+        ThreadPool::setGlobalThreadCount(threads);
+        EXPECT_EQ(kernels::reduceSum(values.data(), 1, values.size(), values.size()), serial) << threads;
+    }
+    EXPECT_NEAR(kernels::reduceSum(values.data(), 1, values.size(), values.size(), kernels::ReductionMode::Fast),
+                serial, 1e-3);
+}
+
+// Test sums over padded and strided storage against the packed result
+TEST_F(ReductionTest, PaddedAndRowSums)
+{
+    Matrix tight(700, 130);
+    tight.randomize(-1.0, 1.0);
+    Matrix padded = Matrix::padded(700, 130);
+    for (int i = 0; i < 700; i++)
+        for (int j = 0; j < 130; j++)
+            padded(i, j) = tight(i, j);
+
+    kernels::setReductionMode(kernels::ReductionMode::Reproducible);
+    EXPECT_NEAR(padded.sum(), tight.sum(), 1e-9);
+    const Matrix rowSums = padded.sumRows();
+    for (int i = 0; i < 700; i += 99)
+    {
+        double expected = 0;
+        for (int j = 0; j < 130; j++)
+            expected += tight(i, j);
+        EXPECT_NEAR(rowSums(i, 0), expected, 1e-12);
+    }
+
+    MatrixI8 bytes(300, 300);
+    bytes += static_cast<int8_t>(-3);
+    EXPECT_EQ(bytes.sum(), -3 * 300 * 300);
+}
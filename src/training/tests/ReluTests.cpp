@@ -96,4 +96,4 @@ TEST(ReluTest, BackwardPass) {
             ASSERT_NEAR(result(i, j), expected(i, j), EPS);
         }
     }
-}
\ No newline at end of file
+}
@@ -109,4 +109,50 @@ TEST(SigmoidTest, BackwardPass) {
             ASSERT_NEAR(result(i, j), expected(i, j), EPS);
         }
     }
-}
\ No newline at end of file
+}
+
+// Large inputs saturate instead of turning into NaN
+TEST(SigmoidTest, NoOverflowForLargeInputs) {
+    Sigmoid s;
+    ASSERT_DOUBLE_EQ(s.activate(1000.0), 1.0);
+    ASSERT_DOUBLE_EQ(s.activate(-1000.0), 0.0);
+    ASSERT_DOUBLE_EQ(s.derivative(1000.0), 0.0);
+
+    Matrix m(1, 2);
+    m(0, 0) = 1000.0;
+    m(0, 1) = -1000.0;
+    const Matrix result = s.forward(m);
+    ASSERT_DOUBLE_EQ(result(0, 0), 1.0);
+    ASSERT_DOUBLE_EQ(result(0, 1), 0.0);
+}
+
+// A fused dense layer matches the product, bias and activation done one after another
+TEST(SigmoidTest, DenseForwardMatchesSeparatePasses) {
+    Sigmoid s;
+    Matrix weights(70, 90), input(90, 33), bias(70, 1);
+    weights.randomize(-1.0, 1.0);
+    input.randomize(-1.0, 1.0);
+    bias.randomize(-1.0, 1.0);
+
+    Matrix z = weights * input;
+    for (int i = 0; i < 70; ++i) {
+        for (int j = 0; j < 33; ++j) {
+            z(i, j) += bias(i, 0);
+        }
+    }
+    const Matrix expected = s.forward(z);
+
+    Matrix out(70, 33), preActivation(70, 33);
+    s.denseForward(weights, input, bias, out, &preActivation);
+    for (int i = 0; i < 70; ++i) {
+        for (int j = 0; j < 33; ++j) {
+            ASSERT_NEAR(out(i, j), expected(i, j), 1e-12);
+            ASSERT_NEAR(preActivation(i, j), z(i, j), 1e-12);
+        }
+    }
+
+    Matrix wrongBias(33, 1);
+    EXPECT_THROW(s.denseForward(weights, input, wrongBias, out), std::invalid_argument);
+    Matrix wrongOut(70, 32);
+    EXPECT_THROW(s.denseForward(weights, input, bias, wrongOut), std::invalid_argument);
+}
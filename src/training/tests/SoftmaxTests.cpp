@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "../include/Matrix.h"
+#include "../include/activation_functions/Softmax.h"
+
+namespace {
+    // Reference softmax of one column, straight from the definition.
+    std::vector<double> referenceColumn(const Matrix& z, const int col) {
+        double maximum = z(0, col);
+        for (int r = 1; r < z.getRows(); r++) maximum = std::max(maximum, z(r, col));
+        std::vector<double> p(z.getRows());
+        double sum = 0;
+        for (int r = 0; r < z.getRows(); r++) sum += p[r] = std::exp(z(r, col) - maximum);
+        for (double& v : p) v /= sum;
+        return p;
+    }
+}
+
+TEST(SoftmaxTest, KnownValues) {
+    Softmax s;
+    std::vector<double> values = {1.0, 2.0, 3.0};
+    s.forwardInPlace(values.data(), values.size());
+    const double sum = std::exp(1.0) + std::exp(2.0) + std::exp(3.0);
+    EXPECT_NEAR(values[0], std::exp(1.0) / sum, 1e-15);
+    EXPECT_NEAR(values[1], std::exp(2.0) / sum, 1e-15);
+    EXPECT_NEAR(values[2], std::exp(3.0) / sum, 1e-15);
+    EXPECT_THROW(s.activate(0.0), std::logic_error);
+    EXPECT_THROW(s.derivative(0.0), std::logic_error);
+}
+
+// Subtracting the column maximum keeps huge logits finite
+TEST(SoftmaxTest, StableForLargeLogits) {
+    Softmax s;
+    Matrix z(3, 2);
+    z(0, 0) = 1000; z(1, 0) = 1001; z(2, 0) = 999;
+    z(0, 1) = -1000; z(1, 1) = -1000; z(2, 1) = -2000;
+    const Matrix p = s.forward(z);
+    for (int c = 0; c < 2; c++) {
+        double sum = 0;
+        for (int r = 0; r < 3; r++) {
+            ASSERT_TRUE(std::isfinite(p(r, c)));
+            sum += p(r, c);
+        }
+        EXPECT_NEAR(sum, 1.0, 1e-15);
+    }
+    EXPECT_NEAR(p(1, 0), 1 / (1 + std::exp(-1.0) + std::exp(-2.0)), 1e-15);
+    EXPECT_NEAR(p(0, 1), 0.5, 1e-15);
+    EXPECT_EQ(p(2, 1), 0.0);
+}
+
+// Each column of a minibatch is normalised on its own, as when passed one at a time
+TEST(SoftmaxTest, BatchMatchesPerSample) {
+    Matrix z(10, 13);
+    z.randomize(-5.0, 5.0);
+    for (ActivationPrecision precision : {ActivationPrecision::Exact, ActivationPrecision::Fast}) {
+        Softmax s(precision);
+        const Matrix batch = s.forward(z);
+        for (int c = 0; c < z.getCols(); c++) {
+            const std::vector<double> expected = referenceColumn(z, c);
+            Matrix column(z.getRows(), 1);
+            for (int r = 0; r < z.getRows(); r++) column(r, 0) = z(r, c);
+            const Matrix single = s.forward(column);
+            for (int r = 0; r < z.getRows(); r++) {
+                EXPECT_NEAR(batch(r, c), expected[r], 1e-11);
+                EXPECT_NEAR(single(r, 0), batch(r, c), 1e-15);
+            }
+        }
+    }
+}
+
+TEST(SoftmaxTest, FloatMatchesDouble) {
+    Matrix z(7, 9);
+    z.randomize(-20.0, 20.0);
+    MatrixF zf(7, 9);
+    for (int r = 0; r < 7; r++) for (int c = 0; c < 9; c++) zf(r, c) = static_cast<float>(z(r, c));
+    for (ActivationPrecision precision : {ActivationPrecision::Exact, ActivationPrecision::Fast}) {
+        const Matrix p = Softmax(precision).forward(z);
+        const MatrixF pf = SoftmaxF(precision).forward(zf);
+        for (int r = 0; r < 7; r++) for (int c = 0; c < 9; c++) EXPECT_NEAR(pf(r, c), p(r, c), 1e-6);
+    }
+}
+
+// The backward pass is the Jacobian-vector product J^T g, checked against finite differences
+TEST(SoftmaxTest, BackwardMatchesFiniteDifferences) {
+    Softmax s;
+    Matrix z(5, 3), g(5, 3);
+    z.randomize(-2.0, 2.0);
+    g.randomize(-1.0, 1.0);
+    const Matrix fromInput = s.backward(g, z);
+    Matrix fromOutput(5, 3);
+    s.backwardFromOutput(g, s.forward(z), fromOutput);
+
+    const double h = 1e-6;
+    for (int r = 0; r < 5; r++) {
+        for (int c = 0; c < 3; c++) {
+            Matrix plus(z), minus(z);
+            plus(r, c) += h;
+            minus(r, c) -= h;
+            const Matrix pPlus = s.forward(plus), pMinus = s.forward(minus);
+            double expected = 0;
+            for (int k = 0; k < 5; k++) expected += g(k, c) * (pPlus(k, c) - pMinus(k, c)) / (2 * h);
+            EXPECT_NEAR(fromInput(r, c), expected, 1e-8);
+            EXPECT_NEAR(fromOutput(r, c), expected, 1e-8);
+        }
+    }
+}
+
+// A dense softmax layer runs the product first and normalises the finished columns
+TEST(SoftmaxTest, DenseForwardMatchesSeparatePasses) {
+    Softmax s;
+    Matrix w(6, 4), x(4, 5), b(6, 1);
+    w.randomize(-1.0, 1.0);
+    x.randomize(-1.0, 1.0);
+    b.randomize(-1.0, 1.0);
+    Matrix out(6, 5), z(6, 5);
+    s.denseForward(w, x, b, out, &z);
+
+    Matrix expectedZ = w * x;
+    for (int r = 0; r < 6; r++) for (int c = 0; c < 5; c++) expectedZ(r, c) += b(r, 0);
+    const Matrix expected = s.forward(expectedZ);
+    for (int r = 0; r < 6; r++) {
+        for (int c = 0; c < 5; c++) {
+            EXPECT_NEAR(z(r, c), expectedZ(r, c), 1e-12);
+            EXPECT_NEAR(out(r, c), expected(r, c), 1e-12);
+        }
+    }
+}
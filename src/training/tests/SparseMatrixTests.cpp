@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include "../include/Matrix.h"
+#include "../include/SparseMatrix.h"
+#include "../include/MLP.h"
+#include "../include/activation_functions/Relu.h"
+#include "../include/activation_functions/Sigmoid.h"
+#include "../include/loss_functions/MSE.h"
+
+// Random matrix with roughly the given fraction of exact zeros
+static Matrix makeSparseDense(const int rows, const int cols, const double zeros, const unsigned seed)
+{
+    std::mt19937 eng(seed);
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+    std::uniform_real_distribution<double> keep(0.0, 1.0);
+    Matrix m(rows, cols);
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++)
+            m(i, j) = keep(eng) < zeros ? 0.0 : value(eng);
+    return m;
+}
+
+static void expectMatrixNear(const Matrix& actual, const Matrix& expected)
+{
+    ASSERT_EQ(actual.getRows(), expected.getRows());
+    ASSERT_EQ(actual.getCols(), expected.getCols());
+    for (int i = 0; i < actual.getRows(); i++)
+        for (int j = 0; j < actual.getCols(); j++)
+            EXPECT_NEAR(actual(i, j), expected(i, j), 1e-12);
+}
+
+// Test compression, element access and the CSR/CSC round trip
+TEST(SparseMatrixTest, ConstructionAndAccess)
+{
+    Matrix dense(3, 4);
+    dense(0, 1) = 2.0;
+    dense(1, 3) = -0.05;
+    dense(2, 0) = 5.0;
+    dense(2, 3) = 1.5;
+
+    const SparseMatrix csr(dense);
+    EXPECT_EQ(csr.nonZeros(), 4u);
+    EXPECT_DOUBLE_EQ(csr.density(), 4.0 / 12.0);
+    EXPECT_EQ(csr.getPointers(), (std::vector<int>{0, 1, 2, 4}));
+    EXPECT_EQ(csr.getIndices(), (std::vector<int>{1, 3, 0, 3}));
+    EXPECT_DOUBLE_EQ(csr(2, 3), 1.5);
+    EXPECT_DOUBLE_EQ(csr(2, 2), 0.0);
+
+    const SparseMatrix csc(dense, Layout::ColumnMajor);
+    EXPECT_EQ(csc.getPointers(), (std::vector<int>{0, 1, 2, 2, 4}));
+    EXPECT_DOUBLE_EQ(csc(1, 3), -0.05);
+    expectMatrixNear(csc.toDense(), dense);
+
+    const SparseMatrix transposed = csr.transposed();
+    EXPECT_EQ(transposed.getLayout(), Layout::ColumnMajor);
+    EXPECT_DOUBLE_EQ(transposed(3, 2), 1.5);
+
+    const SparseMatrix pruned(dense, Layout::RowMajor, 0.1);
+    EXPECT_EQ(pruned.nonZeros(), 3u);
+    EXPECT_DOUBLE_EQ(pruned(1, 3), 0.0);
+
+    MatrixI8 bytes(1, 2);
+    bytes(0, 0) = -128;
+    EXPECT_EQ(SparseMatrixI8(bytes).nonZeros(), 1u);
+
+    EXPECT_EQ(SparseMatrix(2, 3).toDense().sum(), 0.0);
+    EXPECT_THROW(SparseMatrix(2, 2, {0, 1}, {0}, {1.0}), std::invalid_argument);
+    EXPECT_THROW(SparseMatrix(2, 2, {0, 1, 2}, {0, 2}, {1.0, 1.0}), std::invalid_argument);
+    EXPECT_THROW(SparseMatrix(1, 3, {0, 2}, {2, 1}, {1.0, 1.0}), std::invalid_argument);
+}
+
+// Test every sparse product against the dense product
+TEST(SparseMatrixTest, ProductsMatchDense)
+{
+    const Matrix a = makeSparseDense(7, 9, 0.8, 1);
+    const Matrix b = makeSparseDense(9, 5, 0.0, 2);
+    const Matrix expected = a * b;
+
+    expectMatrixNear(SparseMatrix(a) * b, expected);
+    expectMatrixNear(SparseMatrix(a, Layout::ColumnMajor) * b, expected);
+    expectMatrixNear(SparseMatrix(a) * b.col(3), Matrix(expected.col(3)));
+    expectMatrixNear(SparseMatrix(a, Layout::ColumnMajor) * b.col(3), Matrix(expected.col(3)));
+
+    const Matrix w = makeSparseDense(4, 7, 0.0, 3);
+    const Matrix wa = w * a;
+    expectMatrixNear(w * SparseMatrix(a), wa);
+    expectMatrixNear(w * SparseMatrix(a, Layout::ColumnMajor), wa);
+
+    // Column-major dense operands go through the transposed kernel paths
+    const Matrix bt = b.view().transposed();
+    expectMatrixNear(SparseMatrix(a) * bt.view().transposed(), expected);
+    const Matrix at = a.view().transposed();
+    expectMatrixNear(Matrix(b.view().transposed()) * SparseMatrix(at, Layout::ColumnMajor),
+                     Matrix(expected.view().transposed()));
+    const Matrix wt = w.view().transposed();
+    expectMatrixNear(wt.view().transposed() * SparseMatrix(a), wa);
+
+    // alpha and beta accumulate into C
+    Matrix c = expected;
+    gemm(c, SparseMatrix(a), b, 2.0, 1.0);
+    expectMatrixNear(c, expected * 3.0);
+    Matrix d = wa;
+    gemm(d, w, SparseMatrix(a, Layout::ColumnMajor), -1.0, 1.0);
+    EXPECT_NEAR(d.sum(), 0.0, 1e-12);
+
+    EXPECT_THROW(SparseMatrix(a) * a, std::invalid_argument);
+    EXPECT_THROW(b * SparseMatrix(a), std::invalid_argument);
+
+    MatrixI8 q(2, 3), r(3, 2);
+    q(0, 0) = 127; q(1, 2) = -128;
+    r(0, 1) = 100; r(2, 0) = -128; r(2, 1) = 2;
+    const MatrixI32 qr = SparseMatrixI8(q) * r;
+    EXPECT_EQ(qr(0, 1), 127 * 100);
+    EXPECT_EQ(qr(1, 0), 128 * 128);
+    EXPECT_EQ((q * SparseMatrixI8(r))(1, 1), -256);
+}
+
+// Test that a sparse input gives the same forward pass as its dense equivalent
+TEST(SparseMatrixTest, MLPForwardWithSparseInput)
+{
+    auto relu = std::make_shared<Relu>();
+    auto sigmoid = std::make_shared<Sigmoid>();
+    MLP mlp({50, 8, 2}, {relu, sigmoid}, 0.1, std::make_shared<MSE>());
+
+    Matrix x(50, 1);
+    x(3, 0) = 1.0;
+    x(41, 0) = 1.0;
+    const Matrix dense = mlp.forward(x);
+    const Matrix sparse = mlp.forward(SparseMatrix(x, Layout::ColumnMajor));
+    expectMatrixNear(sparse, dense);
+    expectMatrixNear(mlp.forward(SparseMatrix(x)), dense);
+
+    EXPECT_THROW(mlp.forward(SparseMatrix(49, 1)), std::invalid_argument);
+}
+
+// Test that pruned layers run sparse and match the dense pruned weights
+TEST(SparseMatrixTest, MLPPrunedWeights)
+{
+    auto relu = std::make_shared<Relu>();
+    auto sigmoid = std::make_shared<Sigmoid>();
+    MLP mlp({30, 20, 3}, {relu, sigmoid}, 0.1, std::make_shared<MSE>());
+
+    Matrix x(30, 1);
+    x.randomize(-1.0, 1.0);
+    mlp.pruneWeights(0.35);
+    for (const Matrix& w : mlp.weights)
+        for (int i = 0; i < w.getRows(); i++)
+            for (int j = 0; j < w.getCols(); j++)
+                EXPECT_TRUE(w(i, j) == 0.0 || std::abs(w(i, j)) > 0.35);
+
+    const Matrix pruned = mlp.forward(x);
+    const Matrix sparseInput = mlp.forward(SparseMatrix(x));
+
+    // A reference network with the same (already pruned) dense weights
+    MLP reference({30, 20, 3}, {relu, sigmoid}, 0.1, std::make_shared<MSE>());
+    reference.weights = mlp.weights;
+    reference.biases = mlp.biases;
+    expectMatrixNear(pruned, reference.forward(x));
+    expectMatrixNear(sparseInput, pruned);
+
+    // Training updates the dense weights and keeps forward consistent with them
+    Matrix y(3, 1);
+    mlp.backpropagate(x, y);
+    reference.backpropagate(x, y);
+    expectMatrixNear(mlp.forward(x), reference.forward(x));
+}
@@ -124,4 +124,4 @@ TEST(TanhTest, BackwardPass) {
             ASSERT_NEAR(result(i, j), expected(i, j), EPS);
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "../include/Matrix.h"
+#include "../include/ThreadPool.h"
+
+// Test that every index is visited exactly once and chunks respect the grain
+TEST(ThreadPoolTest, ParallelForCoversRangeOnce)
+{
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4);
+
+    std::vector<int> visits(10007, 0);
+    std::atomic<int> chunks{0};
+    pool.parallelFor(3, visits.size(), 100, [&](const size_t first, const size_t last)
+    {
+        EXPECT_GE(last - first, 100u);
+        chunks++;
+        for (size_t i = first; i < last; i++)
+            visits[i]++;
+    });
+    EXPECT_GT(chunks.load(), 1);
+    for (size_t i = 0; i < visits.size(); i++)
+        EXPECT_EQ(visits[i], i < 3 ? 0 : 1);
+}
+
+// Test that work below two grains stays on the calling thread
+TEST(ThreadPoolTest, SmallRangesRunInline)
+{
+    ThreadPool pool(4);
+    const std::thread::id caller = std::this_thread::get_id();
+    int calls = 0;
+    pool.parallelFor(0, 150, 100, [&](const size_t first, const size_t last)
+    {
+        EXPECT_EQ(std::this_thread::get_id(), caller);
+        EXPECT_EQ(first, 0u);
+        EXPECT_EQ(last, 150u);
+        calls++;
+    });
+    pool.parallelFor(5, 5, 1, [&](size_t, size_t) { calls++; });
+    EXPECT_EQ(calls, 1);
+}
+
+// Test that reductions give identical results for any thread count
+TEST(ThreadPoolTest, ReduceIsIndependentOfThreadCount)
+{
+    std::vector<double> values(100000);
+    for (size_t i = 0; i < values.size(); i++)
+        values[i] = 1.0 / static_cast<double>(i + 1);
+
+    const auto chunkSum = [&](const size_t first, const size_t last)
+    {
+        double s = 0;
+        for (size_t i = first; i < last; i++)
+            s += values[i];
+        return s;
+    };
+    const auto add = [](const double a, const double b) { return a + b; };
+
+    ThreadPool serial(1), parallel(4);
+    const double a = serial.parallelReduce(0, values.size(), 1000, 0.0, chunkSum, add);
+    const double b = parallel.parallelReduce(0, values.size(), 1000, 0.0, chunkSum, add);
+    EXPECT_EQ(a, b);
+    EXPECT_NEAR(a, chunkSum(0, values.size()), 1e-9);
+    EXPECT_EQ(parallel.parallelReduce(0, 0, 1000, 7.0, chunkSum, add), 7.0);
+}
+
+// Test nested loops and concurrent callers, which both fall back to serial execution
+TEST(ThreadPoolTest, NestedAndConcurrentLoops)
+{
+    ThreadPool pool(3);
+    std::atomic<long> total{0};
+    const auto nested = [&]
+    {
+        pool.parallelFor(0, 64, 1, [&](const size_t first, const size_t last)
+        {
+            for (size_t i = first; i < last; i++)
+            {
+                pool.parallelFor(0, 100, 1, [&](const size_t a, const size_t b)
+                {
+                    total += static_cast<long>(b - a);
+                });
+            }
+        });
+    };
+
+    std::thread other(nested);
+    nested();
+    other.join();
+    EXPECT_EQ(total.load(), 2L * 64 * 100);
+}
+
+// Test that an exception from a chunk reaches the caller and leaves the pool usable
+TEST(ThreadPoolTest, ExceptionsPropagateToCaller)
+{
+    ThreadPool pool(4);
+    std::atomic<int> started{0};
+    EXPECT_THROW(pool.parallelFor(0, 1000, 1, [&](const size_t first, const size_t)
+    {
+        started++;
+        if (first == 0)
+        {
+            throw std::runtime_error("chunk failed");
+        }
+    }), std::runtime_error);
+    EXPECT_LE(started.load(), pool.size() * 4);
+
+    // The caller is no longer marked as inside a parallel region, and a thrown
+    // reduction is reported the same way
+    std::vector<int> visits(4000, 0);
+    pool.parallelFor(0, visits.size(), 1, [&](const size_t first, const size_t last)
+    {
+        for (size_t i = first; i < last; i++)
+        {
+            visits[i]++;
+        }
+    });
+    for (const int v : visits)
+    {
+        EXPECT_EQ(v, 1);
+    }
+    EXPECT_THROW(pool.parallelReduce(0, 4000, 10, 0, [](const size_t first, const size_t) -> int
+    {
+        if (first > 2000)
+        {
+            throw std::logic_error("late chunk failed");
+        }
+        return 1;
+    }, [](const int a, const int b) { return a + b; }), std::logic_error);
+    EXPECT_EQ(pool.parallelReduce(0, 4000, 10, 0, [](const size_t, const size_t) { return 1; },
+                                  [](const int a, const int b) { return a + b; }), 64);
+}
+
+// Test that threads asking for the shared pool at the same time all get the same one
+TEST(ThreadPoolTest, GlobalPoolIsSharedAcrossThreads)
+{
+    std::vector<ThreadPool*> seen(8, nullptr);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < seen.size(); t++)
+    {
+        threads.emplace_back([&seen, t] { seen[t] = &ThreadPool::global(); });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    for (ThreadPool* pool : seen)
+    {
+        EXPECT_EQ(pool, &ThreadPool::global());
+    }
+}
+
+// Test that Matrix kernels give the same results on the shared pool with several threads
+TEST(ThreadPoolTest, MatrixKernelsMatchSerial)
+{
+    Matrix a(300, 200), b(200, 150), v(200, 1), big(400, 300);
+    a.randomize(-1.0, 1.0);
+    b.randomize(-1.0, 1.0);
+    v.randomize(-1.0, 1.0);
+    big.randomize(-1.0, 1.0);
+    Matrix padded = Matrix::padded(400, 300);
+    padded = big;
+
+    const auto compute = [&]
+    {
+        Matrix scaled = big * 0.5 + big;
+        scaled.axpy(2.0, big);
+        return std::vector<Matrix>{a * b, a * v, a.transposeMultiply(a), big.transpose(), scaled,
+                                   big.sumRows(), Matrix(padded - big)};
+    };
+
+    ThreadPool::setGlobalThreadCount(1);
+    const std::vector<Matrix> serial = compute();
+    const double serialSum = big.sum();
+    ThreadPool::setGlobalThreadCount(4);
+    EXPECT_EQ(ThreadPool::global().size(), 4);
+    const std::vector<Matrix> parallel = compute();
+    const double parallelSum = big.sum();
+    ThreadPool::setGlobalThreadCount(0);
+
+    // Fast-mode reductions may round differently with a different split
+    EXPECT_NEAR(serialSum, parallelSum, 1e-9);
+    for (size_t m = 0; m < serial.size(); m++)
+    {
+        ASSERT_EQ(serial[m].getRows(), parallel[m].getRows());
+        ASSERT_EQ(serial[m].getCols(), parallel[m].getCols());
+        for (int i = 0; i < serial[m].getRows(); i++)
+            for (int j = 0; j < serial[m].getCols(); j++)
+                EXPECT_EQ(serial[m](i, j), parallel[m](i, j)) << "result " << m;
+    }
+}